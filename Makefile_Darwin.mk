@@ -6,7 +6,7 @@
 #    By: W2Wizard <w2.wizzard@gmail.com>              +#+                      #
 #                                                    +#+                       #
 #    Created: 2021/12/28 01:01:14 by W2Wizard      #+#    #+#                  #
-#    Updated: 2022/02/17 15:43:25 by tbruinem      ########   odam.nl          #
+#    Updated: 2022/02/25 16:12:40 by lde-la-h      ########   odam.nl          #
 #                                                                              #
 # **************************************************************************** #
 
@@ -19,9 +19,13 @@ ifneq ($(DYLIB_EXISTS), false)
 	DYLIB_EXISTS = test -e /Users/$(USER)/.brew/opt/glfw/lib/libglfw.3.dylib || echo "false"
 	ifneq ($(DYLIB_EXISTS), false)
 		HEADERS += -I /Users/$(USER)/.brew/opt/glfw/include
+		BENCHLIBS += -L /Users/$(USER)/.brew/opt/glfw/lib
 	endif
 endif
 
+# Only used to link the benchmarks, the library itself is never linked.
+BENCHLIBS += -lglfw -framework Cocoa -framework OpenGL -framework IOKit
+
 # //= Colors =// #
 BOLD	= \033[1m
 GREEN	= \033[32m
@@ -11,5 +11,5 @@
 # **************************************************************************** #
 
 NAME 	=	libmlx42.a
-ARCHIVE	=	-ldl -lglfw -lGL -lX11 -lpthread -lXrandr -lXi
+ARCHIVE	=	-ldl -lglfw -lGL -lX11 -lpthread -lXrandr -lXi -lm
 HEADERS =	-I include lib/lodepng
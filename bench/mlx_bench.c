@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_bench.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 14:33:12 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/25 14:33:12 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "mlx_bench.h"
+
+/**
+ * Headless rendering benchmarks, results are printed as a JSON array.
+ * 
+ * Usage: mlx_bench [--software] [--frames <count>] [--filter <axis>]
+ * The axes are: images, instances, size & dirty.
+ * 
+ * Benchmarks that can't be set up are reported with an error instead,
+ * the exit status tells if any of them failed.
+ */
+
+// Image & instance counts, from 1 up to BENCH_MAX in steps of 10.
+static void	bench_counts(t_opts *opts)
+{
+	int32_t	n;
+
+	n = 1;
+	while (n <= BENCH_MAX)
+	{
+		bench_run(opts, (t_bench){"images", n, 1, {16, 16}, 0});
+		bench_run(opts, (t_bench){"instances", 1, n, {16, 16}, 0});
+		n *= 10;
+	}
+}
+
+// From small sprites up to a 4K canvas, both static and modified.
+static void	bench_sizes(t_opts *opts)
+{
+	int32_t			i;
+	const uint16_t	sizes[6][2] = {{16, 16}, {64, 64}, {256, 256}, \
+	{1024, 1024}, {1920, 1080}, {3840, 2160}};
+
+	i = 0;
+	while (i < 6)
+	{
+		bench_run(opts, (t_bench){"size", 1, 1, {sizes[i][0], \
+		sizes[i][1]}, 0});
+		bench_run(opts, (t_bench){"size", 1, 1, {sizes[i][0], \
+		sizes[i][1]}, 100});
+		i++;
+	}
+}
+
+// A fixed set of images of which an increasing part changes every frame.
+static void	bench_dirty(t_opts *opts)
+{
+	int32_t			i;
+	const int32_t	dirty[5] = {0, 10, 25, 50, 100};
+
+	i = 0;
+	while (i < 5)
+		bench_run(opts, (t_bench){"dirty", 1000, 1, {64, 64}, dirty[i++]});
+}
+
+static bool	bench_options(t_opts *opts, int32_t argc, char **argv)
+{
+	int32_t	i;
+
+	i = 0;
+	*opts = (t_opts){false, 120, NULL, 0, 0};
+	while (++i < argc)
+	{
+		if (!strcmp(argv[i], "--software"))
+			opts->software = true;
+		else if (!strcmp(argv[i], "--frames") && i + 1 < argc)
+			opts->frames = atoi(argv[++i]);
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			opts->filter = argv[++i];
+		else
+			return (false);
+	}
+	return (opts->frames > 0);
+}
+
+int32_t	main(int32_t argc, char **argv)
+{
+	t_opts	opts;
+
+	if (!bench_options(&opts, argc, argv))
+	{
+		fprintf(stderr, "Usage: %s [--software] [--frames <count>] "
+			"[--filter images|instances|size|dirty]\n", argv[0]);
+		return (EXIT_FAILURE);
+	}
+	printf("[");
+	bench_counts(&opts);
+	bench_sizes(&opts);
+	bench_dirty(&opts);
+	printf("\n]\n");
+	if (opts.failed > 0)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}
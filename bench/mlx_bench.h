@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_bench.h                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 14:31:50 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/25 14:31:50 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef MLX_BENCH_H
+# define MLX_BENCH_H
+# include "MLX42/MLX42.h"
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <time.h>
+# define BENCH_WIDTH 1920
+# define BENCH_HEIGHT 1080
+# define BENCH_WARMUP 10
+# define BENCH_MAX 100000
+
+/**
+ * A single benchmark configuration.
+ * 
+ * @param name The axis that is being swept.
+ * @param images The amount of images.
+ * @param instances The amount of instances of every image.
+ * @param size The width & height of every image.
+ * @param dirty The percentage of images modified every frame.
+ */
+typedef struct s_bench
+{
+	const char	*name;
+	int32_t		images;
+	int32_t		instances;
+	uint16_t	size[2];
+	int32_t		dirty;
+}	t_bench;
+
+/**
+ * Options given on the command line.
+ * 
+ * @param software Run on the software backend instead of OpenGL.
+ * @param frames The amount of measured frames per benchmark.
+ * @param filter Only run the benchmarks of this axis, if set.
+ * @param runs The amount of results printed so far.
+ * @param failed The amount of benchmarks that failed.
+ */
+typedef struct s_opts
+{
+	bool		software;
+	int32_t		frames;
+	const char	*filter;
+	int32_t		runs;
+	int32_t		failed;
+}	t_opts;
+
+// State of a running benchmark, the first dirty images change every frame.
+typedef struct s_state
+{
+	t_mlx		*mlx;
+	t_mlx_image	**images;
+	int32_t		count;
+	int32_t		dirty;
+}	t_state;
+
+void	bench_run(t_opts *opts, t_bench bench);
+double	bench_time(void);
+void	bench_hook(void *param);
+void	bench_report(t_opts *opts, t_bench *b, t_mlx_frame_stats *s, \
+double elapsed);
+#endif
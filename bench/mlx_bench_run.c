@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_bench_run.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 15:02:47 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 14:12:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "mlx_bench.h"
+
+// Creates an image and scatters its instances over the frame.
+static bool	bench_image(t_state *state, t_bench *bench, uint32_t *seed)
+{
+	int32_t		i;
+	t_mlx_image	*img;
+
+	i = -1;
+	img = mlx_new_image(state->mlx, bench->size[0], bench->size[1]);
+	if (!img)
+		return (false);
+	state->images[state->count++] = img;
+	memset(img->pixels, 0xC0, img->width * img->height * sizeof(int32_t));
+	while (++i < bench->instances)
+	{
+		*seed = *seed * 1103515245 + 12345;
+		if (mlx_image_to_window(state->mlx, img, \
+			(*seed >> 4) % BENCH_WIDTH - img->width / 2, \
+			(*seed >> 16) % BENCH_HEIGHT - img->height / 2) < 0)
+			return (false);
+	}
+	return (true);
+}
+
+/**
+ * Creates the instance and all images of the benchmark, using a fixed
+ * seed so every run draws exactly the same.
+ */
+static bool	bench_setup(t_opts *opts, t_bench *bench, t_state *state)
+{
+	uint32_t	seed;
+
+	seed = 42;
+	if (opts->software)
+		state->mlx = mlx_init_software(BENCH_WIDTH, BENCH_HEIGHT);
+	else
+		state->mlx = mlx_init_headless(BENCH_WIDTH, BENCH_HEIGHT);
+	state->images = calloc(bench->images, sizeof(t_mlx_image *));
+	state->dirty = bench->images * bench->dirty / 100;
+	if (!state->mlx || !state->images)
+		return (false);
+	while (state->count < bench->images)
+		if (!bench_image(state, bench, &seed))
+			return (false);
+	return (mlx_loop_hook(state->mlx, &bench_hook, state));
+}
+
+/**
+ * Runs a single benchmark on a fresh instance. After a few warmup frames
+ * the statistics are reset, so only the configured frames are measured.
+ * 
+ * @param opts The command line options.
+ * @param bench The benchmark to run.
+ */
+void	bench_run(t_opts *opts, t_bench bench)
+{
+	t_state				state;
+	double				start;
+	t_mlx_frame_stats	stats;
+
+	if (opts->filter && strcmp(opts->filter, bench.name))
+		return ;
+	state = (t_state){NULL, NULL, 0, 0};
+	if (!bench_setup(opts, &bench, &state))
+		bench_report(opts, &bench, NULL, 0);
+	else
+	{
+		mlx_set_frame_limit(state.mlx, BENCH_WARMUP);
+		mlx_loop(state.mlx);
+		mlx_reset_frame_stats(state.mlx);
+		mlx_set_frame_limit(state.mlx, opts->frames);
+		start = bench_time();
+		mlx_loop(state.mlx);
+		mlx_get_frame_stats(state.mlx, &stats);
+		bench_report(opts, &bench, &stats, bench_time() - start);
+	}
+	free(state.images);
+	if (state.mlx)
+		mlx_terminate(state.mlx);
+}
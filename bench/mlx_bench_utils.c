@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_bench_utils.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 15:40:18 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 14:12:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "mlx_bench.h"
+
+// Wall clock time in seconds.
+double	bench_time(void)
+{
+	struct timespec	now;
+
+	timespec_get(&now, TIME_UTC);
+	return (now.tv_sec + now.tv_nsec / 1000000000.0);
+}
+
+// Modifies the first images every frame, each of them entirely.
+void	bench_hook(void *param)
+{
+	int32_t			i;
+	t_mlx_image		*img;
+	const t_state	*state = param;
+
+	i = 0;
+	while (i < state->dirty)
+	{
+		img = state->images[i++];
+		img->pixels[0]++;
+		mlx_image_mark_dirty(img, (uint16_t [2]){0, 0}, \
+		(uint16_t [2]){img->width, img->height});
+	}
+}
+
+/**
+ * Prints the result as JSON, without statistics the setup failed. The
+ * uploaded bytes are the average of the measured frames.
+ */
+void	bench_report(t_opts *opts, t_bench *b, t_mlx_frame_stats *s, \
+double elapsed)
+{
+	const char	*backend = "opengl";
+
+	if (opts->software)
+		backend = "software";
+	if (opts->runs++ > 0)
+		printf(",");
+	printf("\n  {\"name\": \"%s\", \"backend\": \"%s\", \"images\": %d, "
+		"\"instances\": %d, \"width\": %d, \"height\": %d, \"dirty\": %d",
+		b->name, backend, b->images, b->instances, b->size[0], b->size[1],
+		b->dirty);
+	opts->failed += (s == NULL);
+	if (!s)
+		printf(", \"error\": \"setup failed\"}");
+	else
+		printf(", \"frames\": %d, \"fps\": %.2f, \"frame_ms\": %.4f, "
+			"\"frame_p99_ms\": %.4f, \"cpu_ms\": %.4f, \"gpu_ms\": %.4f, "
+			"\"draw_calls\": %u, \"instances_drawn\": %u, "
+			"\"upload_bytes\": %.0f}", opts->frames, opts->frames / elapsed,
+			s->frame.mean, s->frame.p99, s->hooks.mean + s->render.mean,
+			s->gpu.mean, s->draw_calls, s->instances, s->upload_mean);
+	fflush(stdout);
+}
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 00:33:01 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/15 10:05:24 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/04 14:12:37 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -71,8 +71,39 @@ typedef struct s_xpm
 }	t_xpm;
 
 /**
- * An image instance can be summarized as just a simple
- * x, y & z coordinate.
+ * How an image is sampled when its instances are scaled.
+ * @param NEAREST Sharp pixels, the default.
+ * @param LINEAR Smooth blending between neighbouring pixels.
+ * @param TRILINEAR Linear with mipmaps, for images that are scaled down.
+ */
+typedef enum e_mlx_filter
+{
+	MLX_FILTER_NEAREST		= 0,
+	MLX_FILTER_LINEAR		= 1,
+	MLX_FILTER_TRILINEAR	= 2,
+}	t_mlx_filter;
+
+/**
+ * How the pixels of an image are combined with what is already drawn.
+ * @param ALPHA Blended by their alpha, the default.
+ * @param PREMULTIPLIED Same as ALPHA for pixels already multiplied by
+ * their alpha.
+ * @param ADDITIVE Added onto the frame, handy for lights and particles.
+ * @param MULTIPLY Darkens the frame by the color, handy for shadows.
+ * @param OPAQUE Replaces the frame, alpha included.
+ */
+typedef enum e_mlx_blend
+{
+	MLX_BLEND_ALPHA			= 0,
+	MLX_BLEND_PREMULTIPLIED	= 1,
+	MLX_BLEND_ADDITIVE		= 2,
+	MLX_BLEND_MULTIPLY		= 3,
+	MLX_BLEND_OPAQUE		= 4,
+}	t_mlx_blend;
+
+/**
+ * An image instance is mostly a simple x, y & z coordinate, optionally
+ * drawing only part of the image scaled and rotated.
  * 
  * Coordinates start from the top left of the screen at 0,0 and increase
  * towards the bottom right.
@@ -80,23 +111,42 @@ typedef struct s_xpm
  * @param x The x location.
  * @param y The y location.
  * @param z The z depth, controls if the image is on the fore or background.
+ * @param enabled If true the instance is drawn, else its skipped.
+ * @param scale The horizontal & vertical scale, negative values mirror.
+ * @param rotation Clockwise rotation around the center in radians.
+ * @param src The area of the image to draw as x, y, width & height, the
+ * entire image if the width or height is 0. Handy for sprite sheets.
+ * @param tint The red, green, blue & alpha the pixels are multiplied by,
+ * opaque white by default. The alpha sets the opacity of the instance.
  */
 typedef struct s_mlx_instance
 {
 	int32_t			x;
 	int32_t			y;
 	int32_t			z;
+	bool			enabled;
+	float			scale[2];
+	float			rotation;
+	uint16_t		src[4];
+	uint8_t			tint[4];
 }	t_mlx_instance;
 
 /**
  * An image with an individual buffer that can be rendered.
  * Any value can be modified except the width/height and context.
  * 
+ * Only modified areas of the pixels are uploaded to the GPU, mlx_putpixel and
+ * the draw functions keep track of this. When writing to the pixels directly
+ * call mlx_image_mark_dirty afterwards, else the changes won't show up.
+ * 
  * @param width The width of the image.
  * @param height The height of the image.
- * @param pixels The literal pixel data.
- * @param instances An instance carries the X, Y, Z location data.
- * @param count The element count of the instances array.
+ * @param pixels The literal pixel data, RGBA or a palette index per byte
+ * for images made with mlx_new_indexed_image.
+ * @param instances An instance carries the X, Y, Z location data, the
+ * index returned by mlx_image_to_window stays valid until it gets removed.
+ * @param count The element count of the instances array, removed instances
+ * included.
  * @param enabled If true the image is drawn onto the screen, else its not.
  * @param context Abstracted OpenGL data.
  */
@@ -106,11 +156,135 @@ typedef struct s_mlx_image
 	const uint16_t	height;
 	uint8_t			*pixels;
 	t_mlx_instance	*instances;
-	uint16_t		count;
+	uint32_t		count;
 	bool			enabled;
 	void			*context;
 }	t_mlx_image;
 
+/**
+ * A grid of tiles taken from a tileset image, the entire visible area is
+ * drawn with a single quad. Tilemaps are drawn behind every image, in the
+ * order they were created.
+ * 
+ * @param width The amount of columns.
+ * @param height The amount of rows.
+ * @param x The x location of the drawn area on the screen.
+ * @param y The y location of the drawn area on the screen.
+ * @param view The width & height of the drawn area, the window by default.
+ * @param scroll The location in pixels within the map that is shown at
+ * the top left of the drawn area.
+ * @param enabled If true the tilemap is drawn, else its not.
+ * @param context Abstracted OpenGL data.
+ */
+typedef struct s_mlx_tilemap
+{
+	const uint16_t	width;
+	const uint16_t	height;
+	int32_t			x;
+	int32_t			y;
+	uint16_t		view[2];
+	int32_t			scroll[2];
+	bool			enabled;
+	void			*context;
+}	t_mlx_tilemap;
+
+/**
+ * A string drawn with the glyphs of the font, on top of every image.
+ * The text of a frame is drawn with a single draw call.
+ * 
+ * @param x The x location of the top left corner of the text.
+ * @param y The y location of the top left corner of the text.
+ * @param enabled If true the text is drawn, else its not.
+ * @param context Abstracted OpenGL data.
+ */
+typedef struct s_mlx_text
+{
+	int32_t	x;
+	int32_t	y;
+	bool	enabled;
+	void	*context;
+}	t_mlx_text;
+
+/**
+ * A full screen pass over the finished frame, see mlx_add_postprocess.
+ * Passes run in the order they were added.
+ * 
+ * @param enabled If true the pass is run, else its skipped.
+ * @param context Abstracted OpenGL data.
+ */
+typedef struct s_mlx_effect
+{
+	bool	enabled;
+	void	*context;
+}	t_mlx_effect;
+
+/**
+ * Counters of a streaming image, see mlx_image_set_streaming.
+ * 
+ * @param uploads The amount of uploads that went through the buffer ring.
+ * @param waits How often the CPU had to wait for a previous transfer
+ * to finish before it could reuse a buffer.
+ */
+typedef struct s_mlx_stream_stats
+{
+	uint64_t	uploads;
+	uint64_t	waits;
+}	t_mlx_stream_stats;
+
+/**
+ * Rolling timing of a part of the frame, over the last frames.
+ * All values are in milliseconds.
+ * 
+ * @param min The fastest time.
+ * @param mean The average time.
+ * @param p99 The time 99% of the frames stayed within.
+ */
+typedef struct s_mlx_timing
+{
+	double	min;
+	double	mean;
+	double	p99;
+}	t_mlx_timing;
+
+/**
+ * Statistics of the frames rendered by mlx_loop, see mlx_get_frame_stats.
+ * 
+ * @param poll Time spent polling for events.
+ * @param hooks Time spent in the loop hooks.
+ * @param render Time spent uploading and submitting the images.
+ * @param swap Time spent swapping the buffers.
+ * @param gpu Time the GPU spent drawing, this is measured asynchronously
+ * and lags a few frames behind. Always 0 for software instances.
+ * @param frame Time spent on the entire frame.
+ * @param frames The amount of frames the timings cover.
+ * @param draw_calls The amount of draw calls of the last frame.
+ * @param instances The amount of instances drawn in the last frame.
+ * @param upload_bytes The amount of pixel data uploaded in the last frame.
+ * @param upload_mean The average amount of pixel data uploaded per frame
+ * since the statistics were reset.
+ * @param startup The time mlx_init took, in milliseconds.
+ * @param shaders The time spent building shader programs, in milliseconds.
+ * Programs loaded from the program binary cache are a lot faster to build.
+ * @param cache_hits The amount of programs loaded from the cache.
+ */
+typedef struct s_mlx_frame_stats
+{
+	t_mlx_timing	poll;
+	t_mlx_timing	hooks;
+	t_mlx_timing	render;
+	t_mlx_timing	swap;
+	t_mlx_timing	gpu;
+	t_mlx_timing	frame;
+	uint32_t		frames;
+	uint32_t		draw_calls;
+	uint32_t		instances;
+	uint64_t		upload_bytes;
+	double			upload_mean;
+	double			startup;
+	double			shaders;
+	uint32_t		cache_hits;
+}	t_mlx_frame_stats;
+
 /**
  * Main MLX handle, carries important data in regards to the program.
  * @param window The window itself.
@@ -147,6 +321,14 @@ typedef void (*	t_mlx_scrollfunc)(double xdelta, double ydelta, void *param);
  */
 typedef void (*	t_mlx_keyfunc)(t_keys key, t_action action, void *param);
 
+/**
+ * Callback function used once a file loaded by mlx_load_async is ready.
+ * 
+ * @param[in] image The loaded image, NULL if the file could not be loaded.
+ * @param[in] param Additional parameter to pass onto the function.
+ */
+typedef void (*	t_mlx_loadfunc)(t_mlx_image *image, void *param);
+
 //= Generic Functions =//
 
 /**
@@ -161,6 +343,54 @@ typedef void (*	t_mlx_keyfunc)(t_keys key, t_action action, void *param);
 t_mlx		*mlx_init(int32_t Width, int32_t Height, const char *Title, \
 bool Resize);
 
+/**
+ * Initializes a new headless MLX42 Instance, which renders offscreen
+ * instead of into a visible window. Useful for batch jobs and benchmarks.
+ * 
+ * Works without a GPU on a software implementation of OpenGL, such as
+ * Mesa's llvmpipe. Combine with mlx_set_frame_limit so mlx_loop returns
+ * and use mlx_read_frame to retrieve the result.
+ * 
+ * @param[in] width The width of the frame.
+ * @param[in] height The height of the frame.
+ * @returns Ptr to the MLX handle or null on failure.
+ */
+t_mlx		*mlx_init_headless(int32_t width, int32_t height);
+
+/**
+ * Initializes a new MLX42 Instance without OpenGL, every frame is
+ * composited on the CPU instead. For machines with no usable OpenGL at all.
+ * 
+ * Images, instances and hooks work exactly the same, the frame is retrieved
+ * with mlx_read_frame. There is no window, so window, input and cursor
+ * functions as well as mlx_get_time are not available.
+ * 
+ * @param[in] width The width of the frame.
+ * @param[in] height The height of the frame.
+ * @returns Ptr to the MLX handle or null on failure.
+ */
+t_mlx		*mlx_init_software(int32_t width, int32_t height);
+
+/**
+ * Makes mlx_loop return after rendering the given amount of frames,
+ * unless mlx_quit is called earlier. Also resets the frame counter.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] frames The amount of frames, 0 to loop until mlx_quit.
+ */
+void		mlx_set_frame_limit(t_mlx *mlx, uint32_t frames);
+
+/**
+ * Reads the last rendered frame of a headless or software instance back
+ * into memory.
+ * The pixels are RGBA, starting at the top left, just like an image.
+ * 
+ * @param[in] mlx The headless or software MLX instance handle.
+ * @param[out] pixels Buffer of at least width * height * 4 bytes.
+ * @returns Wether the frame could be read.
+ */
+bool		mlx_read_frame(t_mlx *mlx, uint8_t *pixels);
+
 /**
  * Notifies MLX that it should stop rendering and exit the main loop.
  * This is not the same as terminate, this simply tells MLX to close the window.
@@ -188,6 +418,25 @@ void		mlx_loop(t_mlx *mlx);
  */
 bool		mlx_loop_hook(t_mlx *mlx, void (*f)(void *), void *param);
 
+/**
+ * Retrieves the statistics of the frames rendered so far, useful to find
+ * out which part of the frame takes the most time.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[out] stats The statistics.
+ * @returns Wether the statistics could be retrieved.
+ */
+bool		mlx_get_frame_stats(t_mlx *mlx, t_mlx_frame_stats *stats);
+
+/**
+ * Forgets the timings and uploads of the frames rendered so far, so the
+ * statistics only cover the frames that follow. Startup and shader build
+ * times are kept.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ */
+void		mlx_reset_frame_stats(t_mlx *mlx);
+
 /**
  * Lets you set a custom image as the program icon.
  * 
@@ -385,6 +634,16 @@ void		mlx_set_cursor(t_mlx *mlx, void *cursor);
  */
 t_mlx_image	*mlx_xpm42_to_image(t_mlx *mlx, const char *path);
 
+/**
+ * Loads an XPM42 image from the given file path into an indexed image,
+ * its color table becomes the palette. Fails for more than 256 colors.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param path The file path to the XPM image.
+ * @returns The indexed image, NULL on failure.
+ */
+t_mlx_image	*mlx_xpm42_to_indexed(t_mlx *mlx, const char *path);
+
 /**
  * Loads an XPM42 image from the given file path.
  * 
@@ -396,8 +655,8 @@ t_xpm		*mlx_load_xpm42(const char *path);
 /**
  * Draws the xpm picture onto an image.
  * 
- * Drawing the XPM beyond the bounds of an image is considered
- * undefined behaviour!
+ * An XPM that does not fit within the bounds of the image at the
+ * given position is rejected and nothing is drawn.
  * 
  * @param image The image to draw the picture on.
  * @param xpm The picture to draw.
@@ -433,6 +692,53 @@ void		mlx_delete_xpm42(t_xpm **xpm);
 t_mlx_image	*mlx_xpm42_area_to_image(t_mlx *mlx, t_xpm *xpm, uint16_t xy[2], \
 uint16_t wh[2]);
 
+//= TEX42 Functions =//
+
+/**
+ * Loads a TEX42 file, a binary container of raw pixel rows, into a new
+ * image. There is nothing to decode: the file is mapped into memory and
+ * if its rows are packed the image uses them as its pixels, so they are
+ * uploaded straight from the mapping. Writing to the pixels only copies
+ * the pages that were written to.
+ * 
+ * Indexed images are stored along with their palette.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] path The file path to the TEX42 file.
+ * @returns The image, NULL on failure.
+ */
+t_mlx_image	*mlx_tex42_to_image(t_mlx *mlx, const char *path);
+
+/**
+ * Saves the pixels of an image as a TEX42 file, for example an image
+ * loaded from a PNG or XPM42 file to skip decoding it the next time.
+ * See tools/tex42_conv.c for a converter.
+ * 
+ * @param[in] image The image to save, RGBA or indexed.
+ * @param[in] path The file path to write to.
+ * @returns If the file was written.
+ */
+bool		mlx_save_tex42(t_mlx_image *image, const char *path);
+
+//= Async Loading Functions =//
+
+/**
+ * Loads an XPM42 or PNG file into a new image without blocking the loop.
+ * The file is decoded on a background thread, afterwards its pixels are
+ * uploaded a few rows per frame so loading never causes a hitch.
+ * 
+ * Once done the callback is called from within mlx_loop, right after the
+ * loop hooks. Files finish in no particular order.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] path The file path to the image.
+ * @param[in] func The function to receive the image.
+ * @param[in] param The parameter to pass onto the function.
+ * @returns If loading the file was started.
+ */
+bool		mlx_load_async(t_mlx *mlx, const char *path, t_mlx_loadfunc func, \
+void *param);
+
 //= Image Functions =//
 
 /**
@@ -444,11 +750,24 @@ uint16_t wh[2]);
  * @param[in] image The MLX instance handle.
  * @param[in] x The X coordinate position.
  * @param[in] y The Y coordinate position.
- * @param[in] color The RGBA8 Color value.
+ * @param[in] color The RGBA8 Color value, or the palette index for
+ * indexed images.
  */
 void		mlx_putpixel(t_mlx_image *image, int32_t x, \
 int32_t y, uint32_t color);
 
+/**
+ * Marks an area of the image as modified, so that it gets uploaded
+ * again before the next frame is drawn. Only necessary when writing
+ * to the pixel buffer directly, areas beyond the image get clipped.
+ * 
+ * @param[in] img The image that was modified.
+ * @param[in] xy The X & Y location of the modified area.
+ * @param[in] wh The width and height of the modified area.
+ */
+void		mlx_image_mark_dirty(t_mlx_image *img, uint16_t xy[2], \
+uint16_t wh[2]);
+
 /**
  * Creates and allocates a new image buffer.
  * 
@@ -459,18 +778,132 @@ int32_t y, uint32_t color);
  */
 t_mlx_image	*mlx_new_image(t_mlx *mlx, uint16_t width, uint16_t height);
 
+/**
+ * Creates an indexed image, every pixel is a single byte that selects one
+ * of the 256 colors of its palette. Uses a quarter of the memory and upload
+ * bandwidth of a regular image, the colors are looked up while drawing.
+ * 
+ * Indexed images can't be drawn onto with RGBA textures and are always
+ * sampled with MLX_FILTER_NEAREST. The palette starts out transparent.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] width The desired width of the image.
+ * @param[in] height The desired height of the image.
+ * @return Pointer to the image buffer, if it failed to allocate then NULL.
+ */
+t_mlx_image	*mlx_new_indexed_image(t_mlx *mlx, uint16_t width, \
+uint16_t height);
+
+/**
+ * Changes a range of colors in the palette of an indexed image. Only the
+ * palette is uploaded again, so cycling colors costs 1KB per frame
+ * instead of redrawing the pixels.
+ * 
+ * @param[in] img The indexed image.
+ * @param[in] colors The RGBA8 colors, in the format of mlx_putpixel.
+ * @param[in] start The first palette index to change.
+ * @param[in] count The amount of colors.
+ * @return If the colors could be set.
+ */
+bool		mlx_set_palette(t_mlx_image *img, const uint32_t *colors, \
+uint16_t start, uint16_t count);
+
 /**
  * Draws a new instance of an image, it will then share the same
  * pixel buffer as the image.
  * 
+ * The returned index refers to img->instances and does not change when
+ * more instances are added, toggle instances[index].enabled to hide it.
+ * 
  * @param[in] mlx The MLX instance handle.
  * @param[in] img The image to draw onto the screen.
  * @param[in] x The X position.
  * @param[in] y The Y position.
+ * @return Index of the new instance, -1 on failure.
  */
-t_mlx_image	*mlx_image_to_window(t_mlx *mlx, t_mlx_image *img, int32_t x, \
+int32_t		mlx_image_to_window(t_mlx *mlx, t_mlx_image *img, int32_t x, \
 int32_t y);
 
+/**
+ * Removes an instance of an image, it is no longer drawn and its index
+ * may be handed out again by a later call to mlx_image_to_window.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] img The image of the instance.
+ * @param[in] instance The index of the instance.
+ * @return If the instance existed and was removed.
+ */
+bool		mlx_remove_instance(t_mlx *mlx, t_mlx_image *img, \
+int32_t instance);
+
+/**
+ * Enables or disables streaming for an image. Streaming images upload their
+ * pixels through a ring of pixel buffers, so the transfer happens in the
+ * background and the pixels can be written again right away.
+ * 
+ * Useful for images that get redrawn entirely every frame.
+ * 
+ * @param[in] img The image.
+ * @param[in] enable Wether the image should be streamed.
+ * @return If the streaming mode could be changed.
+ */
+bool		mlx_image_set_streaming(t_mlx_image *img, bool enable);
+
+/**
+ * Sets how the image is sampled when its instances are scaled or rotated.
+ * Mipmaps for trilinear filtering are only regenerated after the pixels
+ * were modified, so static images pay for them once.
+ * 
+ * Filtered images get a texture of their own, only the OpenGL backends
+ * filter, the software backend always samples the nearest pixel.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] img The image.
+ * @param[in] filter The filter to use.
+ * @return If the filter could be set.
+ */
+bool		mlx_image_set_filter(t_mlx *mlx, t_mlx_image *img, \
+t_mlx_filter filter);
+
+/**
+ * Sets how the image is blended onto the frame, images sharing the same
+ * blend mode and shader are drawn without switching any state.
+ * 
+ * @param[in] img The image.
+ * @param[in] blend The blend mode to use.
+ * @return If the blend mode could be set.
+ */
+bool		mlx_image_set_blend(t_mlx_image *img, t_mlx_blend blend);
+
+/**
+ * Draws the image with a fragment shader of its own, images using the
+ * same source share a single program. NULL goes back to the default.
+ * 
+ * The shader receives the same inputs as the default one:
+ * - in vec2 TexCoord, the location within the texture.
+ * - in vec4 Tint, the tint of the instance.
+ * - uniform sampler2D OutTexture, the texture of the image.
+ * - uniform sampler2D Palette & uniform bool Indexed, for indexed images.
+ * - uniform int Blend, the blend mode of the image.
+ * Not available for software instances.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] img The image.
+ * @param[in] frag The GLSL 330 core source of the fragment shader.
+ * @return If the shader was built.
+ */
+bool		mlx_image_set_shader(t_mlx *mlx, t_mlx_image *img, \
+const char *frag);
+
+/**
+ * Retrieves the upload counters of a streaming image.
+ * 
+ * @param[in] img The streaming image.
+ * @param[out] stats The counters.
+ * @return False if the image is not streaming.
+ */
+bool		mlx_image_stream_stats(t_mlx_image *img, t_mlx_stream_stats *stats);
+
 /**
  * Deleting an image will remove it from the render queue as well as any and all
  * instances it might have. Additionally, just as extra measures sets all the
@@ -484,4 +917,144 @@ int32_t y);
  */
 void		mlx_delete_image(t_mlx *mlx, t_mlx_image *image);
 
+//= Tilemap Functions =//
+
+/**
+ * Creates a tilemap with every cell empty. The tileset is cut into tiles
+ * left to right, top to bottom. It doesn't need any instances of its own
+ * but has to stay alive as long as the tilemap is used.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] tileset The image holding the tiles.
+ * @param[in] tile The width & height of a single tile.
+ * @param[in] grid The amount of columns & rows of the map.
+ * @return Pointer to the tilemap, NULL on failure.
+ */
+t_mlx_tilemap	*mlx_new_tilemap(t_mlx *mlx, t_mlx_image *tileset, \
+uint16_t tile[2], uint16_t grid[2]);
+
+/**
+ * Changes a single cell of the tilemap, only the modified cells are
+ * uploaded before the next frame.
+ * 
+ * @param[in] map The tilemap.
+ * @param[in] x The column of the cell.
+ * @param[in] y The row of the cell.
+ * @param[in] tile The tile to show, 0 leaves the cell empty and n is the
+ * n-th tile of the tileset, counting from 1.
+ * @return If the cell lies within the map.
+ */
+bool		mlx_set_tile(t_mlx_tilemap *map, uint16_t x, uint16_t y, \
+uint16_t tile);
+
+/**
+ * Retrieves the tile of a cell, see mlx_set_tile.
+ * 
+ * @param[in] map The tilemap.
+ * @param[in] x The column of the cell.
+ * @param[in] y The row of the cell.
+ * @return The tile of the cell, 0 if empty or beyond the map.
+ */
+uint16_t	mlx_get_tile(const t_mlx_tilemap *map, uint16_t x, uint16_t y);
+
+/**
+ * Deletes a tilemap, the tileset is left untouched.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] map The tilemap to delete.
+ */
+void		mlx_delete_tilemap(t_mlx *mlx, t_mlx_tilemap *map);
+
+//= Text Functions =//
+
+/**
+ * Draws a string at the given location until the text is deleted. A new
+ * line character starts a new line, characters beyond ASCII '~' are left
+ * blank. The glyphs are only laid out again when the string changes.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] str The string to draw.
+ * @param[in] x The x location of the top left corner of the text.
+ * @param[in] y The y location of the top left corner of the text.
+ * @return Pointer to the text, NULL on failure.
+ */
+t_mlx_text	*mlx_put_string(t_mlx *mlx, const char *str, int32_t x, \
+int32_t y);
+
+/**
+ * Changes the string of a text, setting the same string again is free.
+ * 
+ * @param[in] text The text.
+ * @param[in] str The new string to draw.
+ * @return If the string could be changed.
+ */
+bool		mlx_set_string(t_mlx_text *text, const char *str);
+
+/**
+ * Deletes a text, it is no longer drawn.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] text The text to delete.
+ */
+void		mlx_delete_text(t_mlx *mlx, t_mlx_text *text);
+
+/**
+ * Replaces the bundled font with a font sheet, for instance one loaded
+ * from a PNG or XPM42 file. The sheet holds the glyphs of the characters
+ * ' ' up to '~' in order, left to right and top to bottom. Each glyph
+ * takes up the same area, spacing included.
+ * 
+ * The sheet doesn't need any instances but has to stay alive as long as
+ * it is used, every text is laid out again with the new glyphs.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] sheet The image holding the glyphs.
+ * @param[in] width The width of a single glyph.
+ * @param[in] height The height of a single glyph.
+ * @return If the sheet holds enough glyphs and became the font.
+ */
+bool		mlx_set_font(t_mlx *mlx, t_mlx_image *sheet, uint16_t width, \
+uint16_t height);
+
+//= Post-processing Functions =//
+
+/**
+ * Adds a fragment shader that runs over the whole frame once everything
+ * else is drawn, each pass reads the output of the previous one. Frames
+ * without enabled passes are drawn straight to the window as usual.
+ * 
+ * The shader receives the frame through these inputs:
+ * - in vec2 TexCoord, the location within the frame from 0 to 1.
+ * - uniform sampler2D Frame, the output of the previous pass.
+ * - uniform vec2 Resolution, the size of the frame in pixels.
+ * - uniform float Time, the seconds since the start.
+ * Not available for software instances.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] frag The GLSL 330 core source of the fragment shader.
+ * @return Pointer to the pass, NULL if the shader failed to build.
+ */
+t_mlx_effect	*mlx_add_postprocess(t_mlx *mlx, const char *frag);
+
+/**
+ * Sets a float, vec2, vec3 or vec4 uniform of a pass, the value is kept
+ * until it is set again. Unknown names are ignored, like OpenGL does.
+ * 
+ * @param[in] effect The pass.
+ * @param[in] name The name of the uniform.
+ * @param[in] value The components of the value.
+ * @param[in] count The amount of components, 1 up to 4.
+ * @return If the value was valid.
+ */
+bool		mlx_set_uniform(t_mlx_effect *effect, const char *name, \
+const float *value, int32_t count);
+
+/**
+ * Deletes a pass, the remaining ones keep their order.
+ * 
+ * @param[in] mlx The MLX instance handle.
+ * @param[in] effect The pass to delete.
+ */
+void		mlx_delete_postprocess(t_mlx *mlx, t_mlx_effect *effect);
+
 #endif
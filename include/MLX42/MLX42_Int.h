@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/27 23:55:34 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/09 17:29:58 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/05 10:05:48 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -35,15 +35,86 @@
 # endif
 # include <ctype.h>
 # include <string.h>
+# include <time.h>
+# include <math.h>
+# include <stddef.h>
+# include <inttypes.h>
+# include <pthread.h>
+# if defined(__AVX2__)
+#  include <immintrin.h>
+#  define MLX_SIMD_WIDTH 8
+# elif defined(__SSE2__)
+#  include <emmintrin.h>
+#  define MLX_SIMD_WIDTH 4
+# else
+#  define MLX_SIMD_WIDTH 1
+# endif
+// Defining a path makes the shader get read from that file instead.
 # ifndef VERTEX_PATH
-#  define VERTEX_PATH "shaders/default.vert"
+#  define VERTEX_PATH NULL
 # endif
 # ifndef FRAGMENT_PATH
-#  define FRAGMENT_PATH "shaders/default.frag"
+#  define FRAGMENT_PATH NULL
+# endif
+# ifndef TILEMAP_VERTEX_PATH
+#  define TILEMAP_VERTEX_PATH NULL
+# endif
+# ifndef TILEMAP_FRAGMENT_PATH
+#  define TILEMAP_FRAGMENT_PATH NULL
 # endif
 # ifndef MLX_SWAP_INTERVAL
 #  define MLX_SWAP_INTERVAL 1
 # endif
+# ifndef MLX_DIRTY_RECTS
+#  define MLX_DIRTY_RECTS 8
+# endif
+# ifndef MLX_ATLAS_SIZE
+#  define MLX_ATLAS_SIZE 2048
+# endif
+# ifndef MLX_ATLAS_SPRITE
+#  define MLX_ATLAS_SPRITE 256
+# endif
+# ifndef MLX_BATCH_RUN
+#  define MLX_BATCH_RUN 32
+# endif
+# ifndef MLX_STREAM_BUFFERS
+#  define MLX_STREAM_BUFFERS 3
+# endif
+# ifndef MLX_STATS_FRAMES
+#  define MLX_STATS_FRAMES 120
+# endif
+# ifndef MLX_LOAD_THREADS
+#  define MLX_LOAD_THREADS 4
+# endif
+# ifndef MLX_LOAD_BUDGET
+#  define MLX_LOAD_BUDGET 4194304
+# endif
+# ifndef MLX_DECODE_THREADS
+#  define MLX_DECODE_THREADS 4
+# endif
+# define MLX_DECODE_SPLIT 262144
+# define MLX_STATS_QUERIES 4
+# define MLX_STREAM_TIMEOUT 1000000000
+# define MLX_PALETTE_SIZE 256
+# define MLX_PALETTE_SLOTS 512
+# define MLX_UNIFORMS 8
+# define MLX_UNIFORM_NAME 32
+# define MLX_GLYPHS 95
+# define MLX_CACHE_PATH 1024
+# define MLX_CACHE_FILE 1056
+# define MLX_CACHE_MAGIC 0x3234584D
+# define MLX_TEX42_MAGIC 0x32345854
+# define MLX_TEX42_VERSION 1
+# define MLX_TEX42_ALIGN 64
+# ifndef GL_PROGRAM_BINARY_LENGTH
+#  define GL_PROGRAM_BINARY_LENGTH 0x8741
+# endif
+# ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#  define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+# endif
+# ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#  define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+# endif
 # define MLX_INVALID_FILE_EXT "Invalid file extension!"
 # define MLX_INVALID_FILE "Failed to read file!"
 # define MLX_INVALID_ARG "Invalid argument provided!"
@@ -52,6 +123,14 @@
 # define MLX_RENDER_FAILURE "Failed to initialize Renderer!"
 # define MLX_MEMORY_FAIL "Failed to allocate enough memory!"
 # define MLX_XPM_FAILURE "Failed to read XPM42 file!"
+# define MLX_TEX42_FAILURE "Failed to read TEX42 file!"
+# define MLX_FRAMEBUFFER_FAILURE "Failed to create framebuffer!"
+# define MLX_NOT_HEADLESS "Only available for headless instances!"
+# define MLX_INSTANCE_LIMIT "Image has too many instances!"
+# define MLX_INDEXED "Not supported for indexed images!"
+# define MLX_PALETTE_LIMIT "Too many colors for an indexed image!"
+# define MLX_NOT_SOFTWARE "Not available for software instances!"
+# define MLX_THREAD_FAILURE "Failed to start the loader threads!"
 # define GLFW_INIT_FAILURE "Failed to initialize GLFW!"
 # define GLFW_WIN_FAILURE "Failed to create GLFW Window!"
 # define GLFW_GLAD_FAILURE "Failed to initialize GLAD!"
@@ -72,7 +151,22 @@ typedef enum e_logtype
 	MLX_ERROR,
 }	t_logtype;
 
-// A single vertex, identical to the layout in the shader.
+// The parts of a frame that are timed separately.
+typedef enum e_mlx_phase
+{
+	MLX_PHASE_POLL,
+	MLX_PHASE_HOOKS,
+	MLX_PHASE_RENDER,
+	MLX_PHASE_SWAP,
+	MLX_PHASE_GPU,
+	MLX_PHASE_FRAME,
+	MLX_PHASE_COUNT,
+}	t_mlx_phase;
+
+/**
+ * A single vertex, identical to the layout in the shader. Only batched
+ * sprites and text use the tint, instances carry their own.
+ */
 typedef struct s_vert
 {
 	float	x;
@@ -80,8 +174,18 @@ typedef struct s_vert
 	float	z;
 	float	u;
 	float	v;
+	uint8_t	tint[4];
 }	t_vert;
 
+// A rectangular area of an image, used to keep track of modified pixels.
+typedef struct s_mlx_rect
+{
+	int32_t	x;
+	int32_t	y;
+	int32_t	w;
+	int32_t	h;
+}	t_mlx_rect;
+
 // Hook layout used to add generic loop hooks.
 typedef struct s_mlx_hook
 {
@@ -89,60 +193,656 @@ typedef struct s_mlx_hook
 	void	(*func)(void*);
 }	t_mlx_hook;
 
-// Layout for linked list.
-typedef struct s_mlx_list
+// Generation checked reference to an image in the slot map.
+typedef struct s_mlx_handle
+{
+	int32_t		slot;
+	uint32_t	generation;
+}	t_mlx_handle;
+
+// Place of an image in the dense array or, once free, the next free slot.
+typedef struct s_mlx_slot
 {
-	void				*content;
-	struct s_mlx_list	*next;
-	struct s_mlx_list	*prev;
-}	t_mlx_list;
+	int32_t		index;
+	uint32_t	generation;
+}	t_mlx_slot;
+
+/**
+ * All images of an instance, stored densely so iterating them is cheap.
+ * A handle refers to a slot which knows where in the array the image is,
+ * so removing one just moves the last image into the gap.
+ * 
+ * Freed slots bump their generation, which invalidates every handle to
+ * the removed image, and are chained together for reuse. The head of
+ * that chain is stored plus one, so 0 means there are no free slots.
+ */
+typedef struct s_mlx_slotmap
+{
+	t_mlx_image	**images;
+	int32_t		count;
+	int32_t		cap;
+	t_mlx_slot	*slots;
+	int32_t		slot_count;
+	int32_t		slot_cap;
+	int32_t		free;
+}	t_mlx_slotmap;
+
+/**
+ * Bookkeeping of a single instance of an image. Removed instances form a
+ * free list so their index can be reused, the generation tells entries of
+ * the render queue apart from those of a previous instance at that index.
+ */
+typedef struct s_mlx_islot
+{
+	uint32_t	generation;
+	int32_t		next;
+	bool		removed;
+}	t_mlx_islot;
 
 // To maintain the drawing order we add every instance to a queue.
 typedef struct s_draw_queue
 {
-	t_mlx_image			*image;
-	t_mlx_instance		*instance;
+	t_mlx_image		*image;
+	t_mlx_handle	handle;
+	int32_t			instance;
+	uint32_t		generation;
 }	t_draw_queue;
 
-// MLX Instance handle context used for OpenGL stuff.
+// A contiguous run of instances of one image, drawn with a single call.
+typedef struct s_mlx_run
+{
+	t_mlx_image	*image;
+	int32_t		start;
+	int32_t		count;
+}	t_mlx_run;
+
+// A single page of the sprite atlas, filled shelf by shelf.
+typedef struct s_mlx_page
+{
+	GLuint	texture;
+	int32_t	shelf_x;
+	int32_t	shelf_y;
+	int32_t	shelf_h;
+	int32_t	used;
+}	t_mlx_page;
+
+/**
+ * A single draw call of a frame. With an image it draws a run of its
+ * instances, else it draws a range of the batched sprite vertices.
+ * Both are drawn with the material & blend mode of their image.
+ */
+typedef struct s_mlx_cmd
+{
+	t_mlx_image	*image;
+	GLuint		texture;
+	int32_t		start;
+	int32_t		count;
+	int32_t		material;
+	t_mlx_blend	blend;
+}	t_mlx_cmd;
+
+/**
+ * A program images are drawn with, the first one is the default program.
+ * Images with the same fragment shader share a material, the key is the
+ * hash of its source and the source itself settles collisions.
+ */
+typedef struct s_mlx_material
+{
+	GLuint		program;
+	uint64_t	key;
+	char		*source;
+	GLint		proj_loc;
+	GLint		size_loc;
+	GLint		uv_loc;
+	GLint		indexed_loc;
+	GLint		blend_loc;
+}	t_mlx_material;
+
+/**
+ * Everything that gets drawn during a frame. All sprite vertices end up
+ * in a single buffer which is uploaded once before the commands execute.
+ */
+typedef struct s_mlx_batch
+{
+	GLuint		vao;
+	GLuint		vbo;
+	t_vert		*verts;
+	int32_t		vert_count;
+	int32_t		vert_cap;
+	t_mlx_cmd	*cmds;
+	int32_t		cmd_count;
+	int32_t		cmd_cap;
+}	t_mlx_batch;
+
+// A single instance to composite by the software backend.
+typedef struct s_mlx_layer
+{
+	t_mlx_image				*image;
+	const t_mlx_instance	*inst;
+	int32_t					z;
+	int32_t					order;
+}	t_mlx_layer;
+
+/**
+ * The shader program and state shared by every tilemap, only created once
+ * the first tilemap is.
+ */
+typedef struct s_mlx_tiler
+{
+	GLuint			program;
+	GLuint			vao;
+	GLint			view_loc;
+	GLint			window_loc;
+	GLint			scroll_loc;
+	GLint			tile_loc;
+	GLint			rect_loc;
+	GLint			indexed_loc;
+	t_mlx_tilemap	**maps;
+	int32_t			count;
+	int32_t			cap;
+}	t_mlx_tiler;
+
+/**
+ * The tiles of a map along with their texture, the tileset is tracked by
+ * its handle so deleting it merely stops the map from being drawn.
+ */
+typedef struct s_mlx_tilemap_ctx
+{
+	GLuint			texture;
+	uint16_t		*tiles;
+	uint16_t		tile[2];
+	t_mlx_image		*tileset;
+	t_mlx_handle	handle;
+	t_mlx_rect		dirty;
+}	t_mlx_tilemap_ctx;
+
+/**
+ * The font every text is drawn with, the bundled one until it is replaced
+ * with mlx_set_font. Like tilesets the sheet is tracked by its handle,
+ * the layout only depends on the glyph size and the glyphs per row.
+ */
+typedef struct s_mlx_font
+{
+	t_mlx_image		*sheet;
+	t_mlx_handle	handle;
+	uint16_t		glyph[2];
+	int32_t			columns;
+	bool			bundled;
+}	t_mlx_font;
+
+/**
+ * Every text along with a buffer holding the glyphs of all of them. The
+ * buffer is only rebuilt and uploaded once a text changed, moved or got
+ * toggled since the previous frame.
+ */
+typedef struct s_mlx_texts
+{
+	t_mlx_batch	batch;
+	t_mlx_font	font;
+	t_mlx_text	**texts;
+	int32_t		count;
+	int32_t		cap;
+	bool		dirty;
+}	t_mlx_texts;
+
+/**
+ * The string of a text and the quads of its glyphs, located relative to
+ * the text and textured in pixels of the font sheet. The location and
+ * state the text had when the buffer was last built are kept to tell if
+ * it has to be rebuilt, dirty is set once the string changed.
+ */
+typedef struct s_mlx_text_ctx
+{
+	char				*str;
+	const t_mlx_font	*font;
+	t_vert				*verts;
+	int32_t				vert_count;
+	int32_t				vert_cap;
+	int32_t				drawn[2];
+	bool				shown;
+	bool				dirty;
+}	t_mlx_text_ctx;
+
+/**
+ * The offscreen targets of the post-processing chain. The frame is drawn
+ * into the first one, the passes then bounce between both until the last
+ * one draws onto the window. Both are resized along with the viewport.
+ */
+typedef struct s_mlx_post
+{
+	GLuint			vao;
+	GLuint			fbo[2];
+	GLuint			texture[2];
+	GLuint			depth;
+	int32_t			size[2];
+	int32_t			last;
+	t_mlx_effect	**effects;
+	int32_t			count;
+	int32_t			cap;
+}	t_mlx_post;
+
+// A uniform of a pass that was looked up before, see mlx_uniform_location.
+typedef struct s_mlx_uniform
+{
+	char	name[MLX_UNIFORM_NAME];
+	GLint	loc;
+}	t_mlx_uniform;
+
+// The program of a post-processing pass along with its builtin uniforms.
+typedef struct s_mlx_effect_ctx
+{
+	GLuint			program;
+	GLint			resolution_loc;
+	GLint			time_loc;
+	t_mlx_uniform	uniforms[MLX_UNIFORMS];
+	int32_t			uniform_count;
+}	t_mlx_effect_ctx;
+
+// Assigns palette indices to the colors of an image, see mlx_xpm42_indexed.c
+typedef struct s_mlx_palette_map
+{
+	uint32_t	colors[MLX_PALETTE_SLOTS];
+	int16_t		index[MLX_PALETTE_SLOTS];
+	uint32_t	palette[MLX_PALETTE_SIZE];
+	int32_t		count;
+}	t_mlx_palette_map;
+
+// Maps the screen back onto a scaled or rotated instance, see mlx_xform.c.
+typedef struct s_mlx_xform
+{
+	int32_t	src[4];
+	float	center[2];
+	float	size[2];
+	float	cos;
+	float	sin;
+}	t_mlx_xform;
+
+// The last samples of a timing in milliseconds, oldest ones get replaced.
+typedef struct s_mlx_ring
+{
+	float	samples[MLX_STATS_FRAMES];
+	int32_t	index;
+	int32_t	count;
+}	t_mlx_ring;
+
+// Work that was done during a single frame.
+typedef struct s_mlx_counts
+{
+	uint32_t	draw_calls;
+	uint32_t	instances;
+	uint64_t	upload_bytes;
+}	t_mlx_counts;
+
+// Entry points of ARB_get_program_binary, which OpenGL 3.3 lacks.
+typedef void	(APIENTRYP t_mlx_getbinary)(GLuint, GLsizei, GLsizei *, \
+GLenum *, void *);
+typedef void	(APIENTRYP t_mlx_putbinary)(GLuint, GLenum, const void *, \
+GLsizei);
+typedef void	(APIENTRYP t_mlx_programhint)(GLuint, GLenum, GLint);
+
+// The header of a cached program binary, which follows right after it.
+typedef struct s_mlx_cache_header
+{
+	uint32_t	magic;
+	uint32_t	format;
+	uint32_t	length;
+}	t_mlx_cache_header;
+
+/**
+ * The on-disk cache of linked shader programs, only used when the driver
+ * supports program binaries and the cache directory is available.
+ */
+typedef struct s_mlx_cache
+{
+	t_mlx_getbinary		get;
+	t_mlx_putbinary		put;
+	t_mlx_programhint	hint;
+	char				dir[MLX_CACHE_PATH];
+}	t_mlx_cache;
+
+/**
+ * An XPM42 file mapped into memory. Once the header is read the color
+ * table and rows are decoded in a single pass from the read position,
+ * the header fields are kept in the XPM which owns no pixels itself.
+ */
+typedef struct s_xpm42_file
+{
+	const char	*data;
+	size_t		size;
+	size_t		pos;
+	t_xpm		xpm;
+}	t_xpm42_file;
+
+/**
+ * An entry of the XPM42 color table hash, the key points into the file.
+ */
+typedef struct s_xpm42_slot
+{
+	const char	*key;
+	uint32_t	color;
+}	t_xpm42_slot;
+
+/**
+ * The color table of an XPM42, chosen by the characters per pixel.
+ * With one or two characters they index the direct table, anything
+ * longer goes through an open addressed hash of at least twice as many
+ * slots as colors. The colors are stored in the byte order of the pixels.
+ * When decoding into an indexed image the map is set and the table holds
+ * palette indices instead, keys it lacks get the missing index.
+ */
+typedef struct s_xpm42_table
+{
+	int32_t				cpp;
+	uint32_t			*direct;
+	t_xpm42_slot		*slots;
+	uint32_t			mask;
+	t_mlx_palette_map	*map;
+	uint8_t				missing;
+}	t_xpm42_table;
+
+/**
+ * A range of rows of an XPM42 decoded on a thread of its own. Every row
+ * is width * cpp characters and a newline, so it starts at a fixed offset
+ * from the end of the color table.
+ */
+typedef struct s_xpm42_part
+{
+	const t_xpm42_file	*file;
+	const t_xpm42_table	*table;
+	uint8_t				*pixels;
+	int32_t				start;
+	int32_t				end;
+	bool				threaded;
+	bool				valid;
+}	t_xpm42_part;
+
+/**
+ * The header of a TEX42 file, 64 bytes so the rows that follow it can
+ * be aligned. The palette of an indexed image follows the header as
+ * RGBA bytes, the rows start at the offset and are stride bytes apart.
+ * Both are multiples of MLX_TEX42_ALIGN, fields are stored in the byte
+ * order of the machine that wrote the file.
+ */
+typedef struct s_tex42_header
+{
+	uint32_t	magic;
+	uint16_t	version;
+	uint16_t	bpp;
+	uint16_t	width;
+	uint16_t	height;
+	uint32_t	stride;
+	uint32_t	palette;
+	uint32_t	offset;
+	uint8_t		reserved[40];
+}	t_tex42_header;
+
+/**
+ * A file being loaded by mlx_load_async. A worker decodes it into the
+ * texture, the main thread then hands the pixels over to an image and
+ * marks its rows for upload, up to the budget of a frame.
+ */
+typedef struct s_mlx_job
+{
+	char				*path;
+	t_mlx_loadfunc		func;
+	void				*param;
+	t_mlx_texture		texture;
+	bool				decoded;
+	t_mlx_image			*image;
+	int32_t				row;
+	struct s_mlx_job	*next;
+}	t_mlx_job;
+
+/**
+ * The worker threads of mlx_load_async, started along with the first
+ * file. Jobs are queued and handed back through the done list under the
+ * lock, the main thread takes the whole list once it finished the last.
+ */
+typedef struct s_mlx_loader
+{
+	pthread_t		threads[MLX_LOAD_THREADS];
+	int32_t			thread_count;
+	pthread_mutex_t	lock;
+	pthread_cond_t	wake;
+	t_mlx_job		*queue;
+	t_mlx_job		*queue_tail;
+	t_mlx_job		*done;
+	t_mlx_job		*finishing;
+	bool			stop;
+}	t_mlx_loader;
+
+/**
+ * Frame statistics. The time of every phase is accumulated in seconds
+ * between marks and pushed into its ring once the frame is done.
+ * 
+ * GPU time is measured by a ring of timer queries, a query is only read
+ * once it is reused and its result is available, so it never stalls.
+ * The time spent on startup and building shader programs is kept apart.
+ */
+typedef struct s_mlx_stats
+{
+	t_mlx_ring		rings[MLX_PHASE_COUNT];
+	double			phase[MLX_PHASE_COUNT];
+	double			start;
+	double			mark;
+	GLuint			queries[MLX_STATS_QUERIES];
+	bool			issued[MLX_STATS_QUERIES];
+	int32_t			query;
+	t_mlx_counts	counts;
+	t_mlx_counts	last;
+	uint64_t		upload_total;
+	uint32_t		upload_frames;
+	double			startup;
+	double			shaders;
+	uint32_t		cache_hits;
+}	t_mlx_stats;
+
+/**
+ * MLX Instance handle context used for OpenGL stuff.
+ * 
+ * Uniform locations are resolved once after linking, the quad uniforms
+ * (ImageSize & UVRect) of the last draw are remembered to avoid uploading
+ * the same values twice. The locations are those of the material in use,
+ * switching materials uploads the remembered values to the new program.
+ * 
+ * Software instances have no OpenGL context at all, they composite every
+ * frame on the CPU into the frame buffer instead.
+ * 
+ * Deleting an image leaves its entries in the render queue behind, they
+ * are recognized by their handle and removed before the next frame.
+ */
 typedef struct s_mlx_ctx
 {
 	GLuint				vao;
 	GLuint				vbo;
 	GLuint				shaderprogram;
-	t_mlx_list			*hooks;
-	t_mlx_list			*images;
-	t_mlx_list			*render_queue;
+	GLint				size_loc;
+	GLint				uv_loc;
+	GLint				indexed_loc;
+	float				quad[6];
+	bool				indexed;
+	t_mlx_material		*materials;
+	int32_t				material_count;
+	int32_t				material_cap;
+	int32_t				material;
+	t_mlx_blend			blend;
+	t_mlx_page			*pages;
+	int32_t				page_count;
+	t_mlx_batch			batch;
+	bool				headless;
+	GLuint				fbo;
+	GLuint				rbo[2];
+	uint32_t			frame_limit;
+	uint32_t			frames;
+	bool				software;
+	bool				closing;
+	double				epoch;
+	uint8_t				*frame;
+	t_mlx_layer			*layers;
+	int32_t				layer_cap;
+	t_mlx_stats			stats;
+	t_mlx_hook			*hooks;
+	int32_t				hook_count;
+	int32_t				hook_cap;
+	t_mlx_slotmap		images;
+	t_mlx_tiler			tiler;
+	t_mlx_texts			texts;
+	t_mlx_post			post;
+	t_mlx_cache			cache;
+	t_mlx_loader		loader;
+	t_draw_queue		*render_queue;
+	int32_t				queue_count;
+	int32_t				queue_cap;
+	bool				queue_stale;
 	t_mlx_scrollfunc	scroll_hook;
 	t_mlx_keyfunc		key_hook;
 }	t_mlx_ctx;
 
-// Additional OpenGL information for images/textures.
+/**
+ * Pixel buffer ring used by streaming images. Each frame the dirty areas
+ * are copied into the next buffer and transferred from there, a fence
+ * tells when the transfer is done and the buffer may be written again.
+ */
+typedef struct s_mlx_stream
+{
+	GLuint		pbo[MLX_STREAM_BUFFERS];
+	GLsync		fence[MLX_STREAM_BUFFERS];
+	int32_t		index;
+	uint64_t	uploads;
+	uint64_t	waits;
+}	t_mlx_stream;
+
+/**
+ * Additional OpenGL information for images/textures.
+ * 
+ * Modified areas of the pixel buffer are collected as dirty rectangles,
+ * these get uploaded once per frame, no matter how many instances exist.
+ * If the rectangles run out, they are merged into a single bounding box.
+ * 
+ * The instances are mirrored in a per instance attribute buffer, the
+ * uploaded copy is kept around to only rewrite it when instances move.
+ * 
+ * Small images don't get a texture of their own but live on a page of
+ * the sprite atlas instead, page is -1 if the image has its own texture.
+ * Images of a software instance have neither, only their pixel buffer.
+ * The pixels of an image loaded from a TEX42 file may point into its
+ * mapping instead, which is unmapped rather than freed.
+ */
 typedef struct s_mlx_image_ctx
 {
-	t_vert	vertices[6];
-	GLuint	texture;
+	GLuint			texture;
+	int32_t			page;
+	int32_t			atlas[2];
+	GLuint			instance_vbo;
+	bool			dirty;
+	int32_t			rect_count;
+	t_mlx_rect		rects[MLX_DIRTY_RECTS];
+	t_mlx_instance	*uploaded;
+	int32_t			uploaded_count;
+	t_mlx_stream	*stream;
+	bool			software;
+	t_mlx_handle	handle;
+	int32_t			instance_cap;
+	t_mlx_islot		*islots;
+	int32_t			islot_cap;
+	int32_t			free_instance;
+	t_mlx_filter	filter;
+	uint8_t			bpp;
+	GLenum			format;
+	uint8_t			*palette;
+	GLuint			palette_tex;
+	bool			palette_dirty;
+	int32_t			material;
+	t_mlx_blend		blend;
+	uint8_t			*map;
+	size_t			map_size;
+	int32_t			tilemaps;
 }	t_mlx_image_ctx;
 
-//= Linked List Functions =//
+//= Slot Map Functions =//
 
-t_mlx_list	*mlx_lstnew(void *content);
-t_mlx_list	*mlx_lstlast(t_mlx_list *lst);
-int32_t		mlx_lstsize(t_mlx_list *lst);
-void		mlx_lstclear(t_mlx_list **lst, void (*del)(void*));
-void		mlx_lstadd_back(t_mlx_list **lst, t_mlx_list *new);
-t_mlx_list	*mlx_lstremove(t_mlx_list **lst, void *value, \
-bool (*comp)(void *, void*));
+bool		mlx_slot_insert(t_mlx_slotmap *map, t_mlx_image *img);
+void		mlx_slot_remove(t_mlx_slotmap *map, t_mlx_handle handle);
+bool		mlx_slot_valid(const t_mlx_slotmap *map, t_mlx_handle handle);
+void		mlx_queue_compact(t_mlx_ctx *mlxctx);
+int32_t		mlx_instance_new(t_mlx_image *img, t_mlx_image_ctx *imgctx);
+bool		mlx_instance_valid(const t_draw_queue *entry);
+
+//= Transform Functions =//
+
+void		mlx_instance_layout(void);
+void		mlx_instance_attribs(int32_t start);
+void		mlx_instance_src(const t_mlx_image *img, \
+const t_mlx_instance *inst, int32_t src[4]);
+void		mlx_instance_corner(const t_mlx_instance *inst, \
+const int32_t src[4], const float corner[2], float out[2]);
+bool		mlx_instance_transformed(const t_mlx_instance *inst);
+
+//= Indexed Functions =//
+
+t_mlx_image	*mlx_image_alloc(t_mlx *mlx, uint16_t width, uint16_t height, \
+uint8_t bpp);
+void		mlx_palette_bind(t_mlx_ctx *mlxctx, const t_mlx_image_ctx *imgctx);
+size_t		mlx_palette_upload(t_mlx_image_ctx *imgctx);
+
+//= Tilemap Functions =//
+
+void		mlx_tilemap_render(t_mlx *mlx);
+void		mlx_tilemap_composite(t_mlx *mlx, uint8_t *frame);
+void		mlx_tilemap_dirty(t_mlx_tilemap_ctx *mapctx, int32_t x, int32_t y);
+void		mlx_free_tilemaps(t_mlx_ctx *mlxctx);
+
+//= Text Functions =//
+
+bool		mlx_font_ready(t_mlx *mlx);
+bool		mlx_font_glyph(const t_mlx_font *font, char c, int32_t src[2]);
+bool		mlx_text_layout(t_mlx_text_ctx *textctx);
+void		mlx_text_render(t_mlx *mlx);
+void		mlx_text_composite(t_mlx *mlx, uint8_t *frame);
+void		mlx_free_texts(t_mlx_ctx *mlxctx);
+
+//= Post-processing Functions =//
+
+void		mlx_post_begin(t_mlx *mlx);
+void		mlx_post_render(t_mlx *mlx);
+void		mlx_free_postprocess(t_mlx_ctx *mlxctx);
+GLint		mlx_uniform_location(t_mlx_effect_ctx *effectctx, const char *name);
+
+//= Loader Functions =//
+
+void		mlx_loader_update(t_mlx *mlx);
+void		mlx_loader_stop(t_mlx_loader *loader);
+void		mlx_free_jobs(t_mlx_job *job);
+
+//= XPM42 Functions =//
+
+bool		mlx_xpm42_open(t_xpm42_file *file, const char *path);
+bool		mlx_xpm42_decode(t_xpm42_file *file, uint8_t *pixels, \
+t_mlx_palette_map *map);
+void		mlx_xpm42_close(t_xpm42_file *file);
+bool		mlx_xpm42_table_init(t_xpm42_table *table, const t_xpm *xpm);
+void		mlx_xpm42_insert(t_xpm42_table *table, const char *key, \
+uint32_t color);
+uint32_t	mlx_xpm42_lookup(const t_xpm42_table *table, const char *key);
+bool		mlx_xpm42_rows(const t_xpm42_file *file, \
+const t_xpm42_table *table, uint8_t *pixels);
+int32_t		mlx_palette_find(t_mlx_palette_map *map, uint32_t color);
 
 //= Misc functions =//
 
-bool		mlx_equal_image(void *lstcontent, void *value);
-bool		mlx_equal_inst(void *lstcontent, void *value);
-void		mlx_xpm_putpixel(t_xpm *xpm, int32_t x, int32_t y, uint32_t color);
-bool		mlx_insert_xpm_entry(t_xpm *xpm, char *line, uint32_t *ctable, \
-size_t s);
-uint32_t	mlx_grab_xpm_pixel(char *pixelstart, uint32_t *ctable, \
-t_xpm *xpm, size_t s);
+void		mlx_draw_pixel(uint8_t *pixel, uint32_t color);
+void		mlx_free_pixels(t_mlx_image *img);
+bool		mlx_blit_texture(t_mlx_image *image, t_mlx_texture *texture, \
+int32_t x, int32_t y);
+
+//= Shaders =//
+
+// Built into the library from the shaders directory, see the Makefile.
+extern const char	*g_default_vert;
+extern const char	*g_default_frag;
+extern const char	*g_tilemap_vert;
+extern const char	*g_tilemap_frag;
+extern const char	*g_post_vert;
 
 //= Error/log Handling Functions =//
 
@@ -155,14 +855,69 @@ char		*mlx_readfile(const char *FilePath);
 
 //= OpenGL Functions =//
 
-bool		mlx_init_shaders(t_mlx *mlx, uint32_t *shaders);
-bool		mlx_compile_shader(const char *Path, int32_t Type, uint32_t *out);
-void		mlx_draw_instance(t_mlx *mlx, t_mlx_image *img, \
-t_mlx_instance *instance);
+bool		mlx_link_program(const uint32_t *shaders, GLuint *program, \
+const t_mlx_cache *cache);
+bool		mlx_init_shaders(t_mlx *mlx);
+bool		mlx_build_program(t_mlx_ctx *mlxctx, const char *const src[2], \
+const char *const path[2], GLuint *program);
+void		mlx_cache_init(t_mlx_ctx *mlxctx);
+bool		mlx_cache_load(const t_mlx_cache *cache, const char *path, \
+GLuint *program);
+void		mlx_cache_store(const t_mlx_cache *cache, const char *path, \
+GLuint program);
+bool		mlx_compile_shader(const char *Source, const char *Path, \
+int32_t Type, uint32_t *out);
+void		mlx_update_matrix(t_mlx *mlx, int32_t width, int32_t height);
+void		mlx_dirty_add(t_mlx_image *img, t_mlx_rect rect);
+void		mlx_upload_images(t_mlx *mlx);
+void		mlx_upload_rect(t_mlx_image *img, t_mlx_rect *rect, void *src);
+void		mlx_stream_upload(t_mlx_image *img);
+void		mlx_stream_free(t_mlx_image_ctx *imgctx);
+void		mlx_draw_instances(t_mlx *mlx, t_mlx_image *img, int32_t start, \
+int32_t count);
+void		mlx_set_quad(t_mlx_ctx *mlxctx, const float quad[6]);
+void		mlx_material_uniforms(t_mlx_material *material);
+int32_t		mlx_material_find(const t_mlx_ctx *mlxctx, const char *frag);
+void		mlx_free_materials(t_mlx_ctx *mlxctx);
+void		mlx_set_state(t_mlx_ctx *mlxctx, int32_t material, \
+t_mlx_blend blend);
+void		mlx_render_frame(t_mlx *mlx);
+bool		mlx_atlas_insert(t_mlx *mlx, t_mlx_image *img);
+void		mlx_atlas_remove(t_mlx *mlx, t_mlx_image *img);
+void		mlx_batch_init(t_mlx_batch *batch);
+void		mlx_batch_run(t_mlx *mlx, t_mlx_run *run);
+GLuint		mlx_create_texture(int32_t width, int32_t height);
+
+//= Statistics Functions =//
+
+void		mlx_ring_push(t_mlx_ring *ring, double ms);
+double		mlx_stats_time(const t_mlx_ctx *mlxctx);
+void		mlx_stats_mark(t_mlx_ctx *mlxctx, t_mlx_phase phase);
+double		mlx_stats_begin(t_mlx_ctx *mlxctx);
+void		mlx_stats_end(t_mlx_ctx *mlxctx);
+void		mlx_stats_gpu_begin(t_mlx_ctx *mlxctx);
+void		mlx_stats_gpu_end(t_mlx_ctx *mlxctx);
+
+//= Software Functions =//
+
+double		mlx_software_time(void);
+void		mlx_software_render(t_mlx *mlx);
+void		mlx_composite_xform(t_mlx *mlx, uint8_t *frame, \
+const t_mlx_layer *l);
+void		mlx_blend_px(uint8_t *dst, const uint8_t *src);
+void		mlx_blend_chunk(uint8_t *dst, const uint8_t *src);
+void		mlx_blend_span(uint8_t *dst, const uint8_t *src, int32_t count);
+void		mlx_blend_row(const t_mlx_image *img, uint8_t *dst, int32_t start, \
+int32_t count);
+void		mlx_blend_layer(const t_mlx_layer *l, uint8_t *dst, int32_t start, \
+int32_t count);
+const uint8_t	*mlx_image_px(const t_mlx_image *img, int32_t index);
 
 // Utils Functions =//
 
 int32_t		mlx_rgba_to_mono(int32_t color);
+bool		mlx_grow(void **data, int32_t *cap, int32_t need, size_t size);
 int32_t		mlx_atoi_base(const char *str, int32_t base);
-uint64_t	mlx_fnv_hash(char *str, size_t len);
+uint64_t	mlx_fnv_hash(const char *str, size_t len);
+uint64_t	mlx_fnv_append(uint64_t hash, const char *str, size_t len);
 #endif
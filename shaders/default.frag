@@ -2,10 +2,23 @@
 #version 330 core
 
 in vec2 TexCoord;
+in vec4 Tint;
 out vec4 FragColor;  
 uniform sampler2D OutTexture;
+uniform sampler2D Palette;
+uniform bool Indexed;
+uniform int Blend;
 
 void main()
 {
-    FragColor = texture(OutTexture, TexCoord);
+	vec4 color = texture(OutTexture, TexCoord);
+
+	if (Indexed)
+		color = texelFetch(Palette, ivec2(color.r * 255.0 + 0.5, 0), 0);
+	color *= Tint;
+	if (Blend == 1)
+		color.rgb *= Tint.a;
+	else if (Blend == 3)
+		color.rgb = mix(vec3(1.0), color.rgb, color.a);
+	FragColor = color;
 }
@@ -3,12 +3,33 @@
 
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec3 aInstance;
+layout(location = 3) in vec3 aTransform;
+layout(location = 4) in vec4 aSource;
+layout(location = 5) in vec4 aTint;
 
 out vec2 TexCoord;
+out vec4 Tint;
 uniform mat4 ProjMatrix;
+uniform vec2 ImageSize;
+uniform vec4 UVRect;
 
 void main()
 {
-	gl_Position = ProjMatrix * vec4(aPos, 1.0);
-    TexCoord = aTexCoord;
+	vec4 src = aSource;
+	if (src.z == 0.0 || src.w == 0.0)
+		src = vec4(0.0, 0.0, ImageSize);
+	src.xy = min(src.xy, ImageSize);
+	src.zw = min(src.zw, ImageSize - src.xy);
+
+	vec2 size = src.zw * aTransform.xy;
+	vec2 local = (aPos.xy - 0.5) * size;
+	float c = cos(aTransform.z);
+	float s = sin(aTransform.z);
+	vec2 center = aInstance.xy + abs(size) * 0.5;
+	vec2 pos = center + vec2(local.x * c - local.y * s, local.x * s + local.y * c);
+
+	gl_Position = ProjMatrix * vec4(pos, aInstance.z + aPos.z, 1.0);
+	Tint = aTint;
+    TexCoord = UVRect.xy + (src.xy + aTexCoord * src.zw) / ImageSize * UVRect.zw;
 }
@@ -0,0 +1,11 @@
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+
+out vec2 TexCoord;
+
+void main()
+{
+	TexCoord = aPos.xy;
+	gl_Position = vec4(aPos.xy * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,34 @@
+
+#version 330 core
+
+in vec2 Pixel;
+out vec4 FragColor;
+uniform usampler2D Tiles;
+uniform sampler2D Tileset;
+uniform sampler2D Palette;
+uniform bool Indexed;
+uniform ivec2 Scroll;
+uniform ivec2 TileSize;
+uniform ivec4 TilesetRect;
+
+void main()
+{
+	ivec2 p = ivec2(floor(Pixel)) + Scroll;
+	if (p.x < 0 || p.y < 0)
+		discard;
+	ivec2 cell = p / TileSize;
+	if (any(greaterThanEqual(cell, textureSize(Tiles, 0))))
+		discard;
+
+	// Tile 0 is empty, tile n is the n-th tile of the tileset.
+	int id = int(texelFetch(Tiles, cell, 0).r) - 1;
+	ivec2 grid = TilesetRect.zw / TileSize;
+	if (id < 0 || id >= grid.x * grid.y)
+		discard;
+
+	ivec2 texel = TilesetRect.xy + ivec2(id % grid.x, id / grid.x) * TileSize + p - cell * TileSize;
+	vec4 color = texelFetch(Tileset, texel, 0);
+	if (Indexed)
+		color = texelFetch(Palette, ivec2(color.r * 255.0 + 0.5, 0), 0);
+	FragColor = color;
+}
@@ -0,0 +1,16 @@
+
+#version 330 core
+
+layout(location = 0) in vec3 aPos;
+
+out vec2 Pixel;
+uniform vec4 View;
+uniform vec2 Window;
+
+void main()
+{
+	vec2 pos = View.xy + aPos.xy * View.zw;
+
+	Pixel = aPos.xy * View.zw;
+	gl_Position = vec4(pos.x / Window.x * 2.0 - 1.0, 1.0 - pos.y / Window.y * 2.0, 0.0, 1.0);
+}
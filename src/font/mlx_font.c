@@ -0,0 +1,119 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_font.c                                         :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 17:06:48 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 17:06:48 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include "mlx_font.h"
+
+// Draws the bundled glyphs in white onto a transparent sheet.
+static void	mlx_font_draw(t_mlx_image *sheet)
+{
+	int32_t	i;
+	int32_t	x;
+	int32_t	y;
+	int32_t	src[2];
+
+	i = -1;
+	while (++i < MLX_GLYPHS)
+	{
+		src[0] = i % MLX_FONT_COLUMNS * MLX_FONT_WIDTH;
+		src[1] = i / MLX_FONT_COLUMNS * MLX_FONT_HEIGHT;
+		y = -1;
+		while (++y < 9)
+		{
+			x = -1;
+			while (++x < 5)
+				if (g_mlx_font[i][y] & (0x10 >> x))
+					mlx_putpixel(sheet, src[0] + x, src[1] + y, 0xFFFFFFFF);
+		}
+	}
+}
+
+// Switches to another font, every text is laid out again with its glyphs.
+static bool	mlx_font_apply(t_mlx_texts *texts, t_mlx_image *sheet, \
+uint16_t width, uint16_t height)
+{
+	int32_t	i;
+
+	i = 0;
+	texts->font = (t_mlx_font){sheet, \
+	((t_mlx_image_ctx *)sheet->context)->handle, {width, height}, \
+	sheet->width / width, false};
+	texts->dirty = true;
+	while (i < texts->count)
+		if (!mlx_text_layout(texts->texts[i++]->context))
+			return (false);
+	return (true);
+}
+
+/**
+ * Makes sure there is a font to lay out text with, the bundled font is
+ * created once it is needed for the first time or after the sheet of
+ * the font in use got deleted.
+ * 
+ * @param mlx The MLX instance handle.
+ * @return If a font is available.
+ */
+bool	mlx_font_ready(t_mlx *mlx)
+{
+	t_mlx_ctx	*mlxctx;
+	t_mlx_image	*sheet;
+
+	mlxctx = mlx->context;
+	if (mlxctx->texts.font.sheet && \
+		mlx_slot_valid(&mlxctx->images, mlxctx->texts.font.handle))
+		return (true);
+	sheet = mlx_new_image(mlx, MLX_FONT_COLUMNS * MLX_FONT_WIDTH, \
+	(MLX_GLYPHS + MLX_FONT_COLUMNS - 1) / MLX_FONT_COLUMNS * MLX_FONT_HEIGHT);
+	if (!sheet)
+		return (false);
+	mlx_font_draw(sheet);
+	mlx_font_apply(&mlxctx->texts, sheet, MLX_FONT_WIDTH, MLX_FONT_HEIGHT);
+	mlxctx->texts.font.bundled = true;
+	return (true);
+}
+
+/**
+ * Locates the glyph of a character on the font sheet.
+ * 
+ * @param font The font.
+ * @param c The character.
+ * @param src Set to the top left corner of the glyph on the sheet.
+ * @return False for characters that are left blank, like space.
+ */
+bool	mlx_font_glyph(const t_mlx_font *font, char c, int32_t src[2])
+{
+	if (c <= ' ' || c > '~')
+		return (false);
+	src[0] = (c - ' ') % font->columns * font->glyph[0];
+	src[1] = (c - ' ') / font->columns * font->glyph[1];
+	return (true);
+}
+
+//= Exposed =//
+
+bool	mlx_set_font(t_mlx *mlx, t_mlx_image *sheet, uint16_t width, \
+uint16_t height)
+{
+	t_mlx_texts	*texts;
+
+	if (!mlx || !sheet)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (!width || !height || \
+		(sheet->width / width) * (sheet->height / height) < MLX_GLYPHS)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	texts = &((t_mlx_ctx *)mlx->context)->texts;
+	if (texts->font.bundled && texts->font.sheet != sheet && \
+		mlx_slot_valid(&((t_mlx_ctx *)mlx->context)->images, \
+		texts->font.handle))
+		mlx_delete_image(mlx, texts->font.sheet);
+	return (mlx_font_apply(texts, sheet, width, height));
+}
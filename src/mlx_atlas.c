@@ -0,0 +1,144 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_atlas.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/21 10:47:02 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/26 18:15:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Small images are packed together on shared atlas pages, that way many
+ * different sprites can be drawn from a single texture in one draw call.
+ * 
+ * Pages are filled shelf by shelf, left to right. Space is only reclaimed
+ * once every image on a page is deleted, the page then starts over.
+ */
+
+/**
+ * Creates a texture to upload pixels to, its content starts out undefined.
+ * 
+ * @param width The width of the texture.
+ * @param height The height of the texture.
+ * @return The texture.
+ */
+GLuint	mlx_create_texture(int32_t width, int32_t height)
+{
+	GLuint	texture;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, \
+	GL_UNSIGNED_BYTE, NULL);
+	return (texture);
+}
+
+// Creates a new, empty, page for the atlas.
+static t_mlx_page	*mlx_new_page(t_mlx_ctx *mlxctx)
+{
+	t_mlx_page	*temp;
+
+	temp = realloc(mlxctx->pages, (mlxctx->page_count + 1) * \
+	sizeof(t_mlx_page));
+	if (!temp)
+		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	mlxctx->pages = temp;
+	temp = &mlxctx->pages[mlxctx->page_count++];
+	*temp = (t_mlx_page){0, 0, 0, 0, 0};
+	temp->texture = mlx_create_texture(MLX_ATLAS_SIZE, MLX_ATLAS_SIZE);
+	return (temp);
+}
+
+/**
+ * Tries to find a spot for the given size on the page, a one pixel
+ * gutter is kept between sprites.
+ * 
+ * @param page The page to place the sprite on.
+ * @param w The width of the sprite.
+ * @param h The height of the sprite.
+ * @param out The resulting location on the page.
+ * @return Wether the sprite fits on the page.
+ */
+static bool	mlx_page_fit(t_mlx_page *page, int32_t w, int32_t h, \
+int32_t out[2])
+{
+	int32_t	x;
+	int32_t	y;
+
+	x = page->shelf_x;
+	y = page->shelf_y;
+	if (x + w > MLX_ATLAS_SIZE)
+	{
+		x = 0;
+		y = page->shelf_y + page->shelf_h;
+	}
+	if (y + h > MLX_ATLAS_SIZE)
+		return (false);
+	if (y != page->shelf_y)
+		page->shelf_h = 0;
+	page->shelf_y = y;
+	page->shelf_x = x + w + 1;
+	if (h + 1 > page->shelf_h)
+		page->shelf_h = h + 1;
+	page->used++;
+	out[0] = x;
+	out[1] = y;
+	return (true);
+}
+
+/**
+ * Places the image on one of the atlas pages, if it is small enough.
+ * The image then shares the texture of that page.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param img The image to place.
+ * @return True if the image now lives in the atlas.
+ */
+bool	mlx_atlas_insert(t_mlx *mlx, t_mlx_image *img)
+{
+	int32_t			i;
+	t_mlx_ctx		*mlxctx;
+	t_mlx_image_ctx	*imgctx;
+
+	if (img->width > MLX_ATLAS_SPRITE || img->height > MLX_ATLAS_SPRITE || \
+		img->width == 0 || img->height == 0)
+		return (false);
+	i = 0;
+	mlxctx = mlx->context;
+	imgctx = img->context;
+	while (i < mlxctx->page_count && !mlx_page_fit(&mlxctx->pages[i], \
+		img->width, img->height, imgctx->atlas))
+		i++;
+	if (i == mlxctx->page_count && (!mlx_new_page(mlxctx) || \
+		!mlx_page_fit(&mlxctx->pages[i], img->width, img->height, \
+		imgctx->atlas)))
+		return (false);
+	imgctx->page = i;
+	imgctx->texture = mlxctx->pages[i].texture;
+	return (true);
+}
+
+// Releases the spot of the image, empty pages start over from scratch.
+void	mlx_atlas_remove(t_mlx *mlx, t_mlx_image *img)
+{
+	t_mlx_page		*page;
+	t_mlx_image_ctx	*imgctx;
+
+	imgctx = img->context;
+	page = &((t_mlx_ctx *)mlx->context)->pages[imgctx->page];
+	if (--page->used == 0)
+		*page = (t_mlx_page){page->texture, 0, 0, 0, 0};
+	imgctx->page = -1;
+	imgctx->texture = 0;
+	imgctx->atlas[0] = 0;
+	imgctx->atlas[1] = 0;
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_batch.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/21 13:05:51 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Writes the six vertices of a single sprite instance into the batch,
+ * transformed the same way the vertex shader would.
+ */
+static void	mlx_batch_quad(t_vert *v, t_mlx_image *img, t_mlx_instance *inst)
+{
+	int32_t					i;
+	int32_t					src[4];
+	float					pos[2];
+	const t_mlx_image_ctx	*imgctx = img->context;
+	const float				corners[6][2] = {
+	{0, 0}, {1, 1}, {1, 0}, {0, 0}, {0, 1}, {1, 1}};
+
+	i = -1;
+	mlx_instance_src(img, inst, src);
+	while (++i < 6)
+	{
+		mlx_instance_corner(inst, src, corners[i], pos);
+		v[i] = (t_vert){pos[0], pos[1], inst->z, \
+		(imgctx->atlas[0] + src[0] + corners[i][0] * src[2]) / \
+		(float)MLX_ATLAS_SIZE, \
+		(imgctx->atlas[1] + src[1] + corners[i][1] * src[3]) / \
+		(float)MLX_ATLAS_SIZE, {0, 0, 0, 0}};
+		memcpy(v[i].tint, inst->tint, sizeof(v[i].tint));
+	}
+}
+
+/**
+ * Adds a command, merging it with the previous one if it continues the
+ * batch with the same texture, material and blend mode.
+ */
+static void	mlx_batch_cmd(t_mlx_batch *batch, t_mlx_cmd cmd)
+{
+	t_mlx_cmd	*last;
+
+	if (batch->cmd_count > 0)
+	{
+		last = &batch->cmds[batch->cmd_count - 1];
+		if (!last->image && !cmd.image && last->texture == cmd.texture && \
+			last->material == cmd.material && last->blend == cmd.blend)
+		{
+			last->count += cmd.count;
+			return ;
+		}
+	}
+	if (mlx_grow((void **)&batch->cmds, &batch->cmd_cap, \
+		batch->cmd_count + 1, sizeof(t_mlx_cmd)))
+		batch->cmds[batch->cmd_count++] = cmd;
+}
+
+/**
+ * Creates the vertex array for the batched sprites, these carry their
+ * full location and tint so the per instance attributes are replaced by
+ * those of the vertices.
+ * 
+ * @param batch The batch to initialize.
+ */
+void	mlx_batch_init(t_mlx_batch *batch)
+{
+	glGenVertexArrays(1, &batch->vao);
+	glGenBuffers(1, &batch->vbo);
+	glBindVertexArray(batch->vao);
+	glBindBuffer(GL_ARRAY_BUFFER, batch->vbo);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(t_vert), NULL);
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(t_vert), \
+	(void *)(sizeof(float) * 3));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(t_vert), \
+	(void *)offsetof(t_vert, tint));
+	glEnableVertexAttribArray(5);
+}
+
+/**
+ * Turns a run of instances into draw commands. Images with their own
+ * texture and long runs are drawn instanced, short runs of atlas images
+ * are written into the sprite vertex stream instead.
+ * 
+ * Consecutive sprites on the same atlas page end up in the same command,
+ * so a new draw call is only needed once the page changes.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param run The run to add, it is reset afterwards.
+ */
+void	mlx_batch_run(t_mlx *mlx, t_mlx_run *run)
+{
+	int32_t			i;
+	t_mlx_batch		*batch;
+	t_mlx_image_ctx	*imgctx;
+
+	if (run->count == 0)
+		return ;
+	batch = &((t_mlx_ctx *)mlx->context)->batch;
+	imgctx = run->image->context;
+	if (imgctx->page < 0 || run->count >= MLX_BATCH_RUN)
+		mlx_batch_cmd(batch, (t_mlx_cmd){run->image, 0, run->start, \
+		run->count, imgctx->material, imgctx->blend});
+	else if (mlx_grow((void **)&batch->verts, \
+		&batch->vert_cap, batch->vert_count + run->count * 6, sizeof(t_vert)))
+	{
+		i = -1;
+		while (++i < run->count)
+			mlx_batch_quad(&batch->verts[batch->vert_count + i * 6], \
+			run->image, &run->image->instances[run->start + i]);
+		mlx_batch_cmd(batch, (t_mlx_cmd){NULL, imgctx->texture, \
+		batch->vert_count, run->count * 6, imgctx->material, imgctx->blend});
+		batch->vert_count += run->count * 6;
+	}
+	run->count = 0;
+}
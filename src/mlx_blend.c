@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_blend.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/24 09:41:12 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Gets the RGBA value of a pixel, indexed images look it up in their
+ * palette.
+ * 
+ * @param img The image.
+ * @param index The index of the pixel.
+ * @return The RGBA bytes of the pixel.
+ */
+const uint8_t	*mlx_image_px(const t_mlx_image *img, int32_t index)
+{
+	const t_mlx_image_ctx	*imgctx = img->context;
+
+	if (imgctx->palette)
+		return (&imgctx->palette[img->pixels[index] * sizeof(int32_t)]);
+	return (&img->pixels[index * sizeof(int32_t)]);
+}
+
+/**
+ * Blends a single RGBA pixel over another, the same way OpenGL does with
+ * glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA), alpha included.
+ * 
+ * Dividing by 255 is done as (x + (x >> 8)) >> 8 on the rounded value,
+ * which is exact for every product of two bytes.
+ * 
+ * @param dst The pixel to blend onto.
+ * @param src The pixel to blend.
+ */
+void	mlx_blend_px(uint8_t *dst, const uint8_t *src)
+{
+	int32_t			i;
+	uint32_t		x;
+	const uint32_t	alpha = src[3];
+
+	if (alpha == 0)
+		return ;
+	if (alpha == 255)
+	{
+		memcpy(dst, src, sizeof(int32_t));
+		return ;
+	}
+	i = -1;
+	while (++i < 4)
+	{
+		x = src[i] * alpha + dst[i] * (255 - alpha) + 128;
+		dst[i] = (x + (x >> 8)) >> 8;
+	}
+}
+
+/**
+ * Blends a horizontal span of pixels, as many as possible at once.
+ * Whole chunks that are fully transparent are skipped and fully opaque
+ * ones are simply copied, only the rest is actually blended.
+ * 
+ * @param dst The first pixel of the span in the frame.
+ * @param src The first pixel of the span in the image.
+ * @param count The amount of pixels in the span.
+ */
+void	mlx_blend_span(uint8_t *dst, const uint8_t *src, int32_t count)
+{
+	int32_t	i;
+
+	i = 0;
+	while (i + MLX_SIMD_WIDTH <= count)
+	{
+		mlx_blend_chunk(&dst[i * sizeof(int32_t)], &src[i * sizeof(int32_t)]);
+		i += MLX_SIMD_WIDTH;
+	}
+	while (i < count)
+	{
+		mlx_blend_px(&dst[i * sizeof(int32_t)], &src[i * sizeof(int32_t)]);
+		i++;
+	}
+}
+
+/**
+ * Blends a row of pixels of an image, RGBA images in spans and indexed
+ * images pixel by pixel through their palette.
+ * 
+ * @param img The image.
+ * @param dst The pixels to blend onto.
+ * @param start The index of the first pixel of the row.
+ * @param count The amount of pixels in the row.
+ */
+void	mlx_blend_row(const t_mlx_image *img, uint8_t *dst, int32_t start, \
+int32_t count)
+{
+	int32_t	i;
+
+	if (!((t_mlx_image_ctx *)img->context)->palette)
+	{
+		mlx_blend_span(dst, &img->pixels[start * sizeof(int32_t)], count);
+		return ;
+	}
+	i = -1;
+	while (++i < count)
+		mlx_blend_px(&dst[i * sizeof(int32_t)], mlx_image_px(img, start + i));
+}
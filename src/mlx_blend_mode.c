@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_blend_mode.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/01 10:12:38 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Divides by 255 with rounding, clamped for sums of several products.
+static uint8_t	mlx_div255(uint32_t x)
+{
+	x += 128;
+	x = (x + (x >> 8)) >> 8;
+	if (x > 255)
+		return (255);
+	return (x);
+}
+
+/**
+ * Multiplies a pixel by the tint of its instance, premultiplied pixels
+ * are scaled by the opacity of the tint as well, like the shader does.
+ */
+static void	mlx_tint_px(uint8_t *out, const uint8_t *src, const uint8_t *tint, \
+t_mlx_blend blend)
+{
+	int32_t	i;
+
+	i = -1;
+	while (++i < 4)
+		out[i] = mlx_div255(src[i] * tint[i]);
+	i = -1;
+	while (blend == MLX_BLEND_PREMULTIPLIED && ++i < 3)
+		out[i] = mlx_div255(out[i] * tint[3]);
+}
+
+/**
+ * Blends a single tinted pixel with the given blend mode, the same way
+ * the blend functions of the OpenGL backend do.
+ * 
+ * @param dst The pixel to blend onto.
+ * @param s The tinted pixel to blend.
+ * @param blend The blend mode.
+ */
+static void	mlx_blend_mode_px(uint8_t *dst, const uint8_t *s, t_mlx_blend blend)
+{
+	int32_t			i;
+	uint32_t		x;
+	const uint32_t	a = s[3];
+
+	i = -1;
+	while (++i < 4)
+	{
+		if (blend == MLX_BLEND_OPAQUE)
+			x = s[i] * 255;
+		else if (blend == MLX_BLEND_ADDITIVE)
+			x = dst[i] * 255 + s[i] * a;
+		else if (blend == MLX_BLEND_MULTIPLY && i < 3)
+			x = dst[i] * mlx_div255(255 * (255 - a) + s[i] * a);
+		else if (blend == MLX_BLEND_MULTIPLY)
+			x = dst[i] * 255;
+		else if (blend == MLX_BLEND_PREMULTIPLIED)
+			x = s[i] * 255 + dst[i] * (255 - a);
+		else
+			x = s[i] * a + dst[i] * (255 - a);
+		dst[i] = mlx_div255(x);
+	}
+}
+
+/**
+ * Blends a row of pixels of an instance. Untinted instances of images
+ * blended by alpha take the faster path of mlx_blend_row, any other is
+ * tinted and blended pixel by pixel.
+ * 
+ * @param l The layer of the instance.
+ * @param dst The pixels to blend onto.
+ * @param start The index of the first pixel of the row.
+ * @param count The amount of pixels in the row.
+ */
+void	mlx_blend_layer(const t_mlx_layer *l, uint8_t *dst, int32_t start, \
+int32_t count)
+{
+	int32_t				i;
+	uint8_t				px[4];
+	const t_mlx_blend	blend = ((t_mlx_image_ctx *)l->image->context)->blend;
+
+	if (blend == MLX_BLEND_ALPHA && l->inst->tint[0] == 255 && \
+		l->inst->tint[1] == 255 && l->inst->tint[2] == 255 && \
+		l->inst->tint[3] == 255)
+	{
+		mlx_blend_row(l->image, dst, start, count);
+		return ;
+	}
+	i = -1;
+	while (++i < count)
+	{
+		mlx_tint_px(px, mlx_image_px(l->image, start + i), l->inst->tint, \
+		blend);
+		mlx_blend_mode_px(&dst[i * sizeof(int32_t)], px, blend);
+	}
+}
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_blend_simd.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/24 10:27:55 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/24 10:27:55 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Chunked variants of mlx_blend_px, which one is used depends on the
+ * instruction sets the library is compiled for. SSE2 is always there on
+ * x86-64, AVX2 has to be enabled explicitly by building with AVX2=1.
+ * 
+ * Pixels are widened to 16 bits per channel, so two bytes can be
+ * multiplied, with the alpha of every pixel spread over its channels.
+ */
+#if defined(__AVX2__)
+
+static __m256i	mlx_blend_half(__m256i s, __m256i d, __m256i a)
+{
+	__m256i	x;
+
+	x = _mm256_sub_epi16(_mm256_set1_epi16(255), a);
+	x = _mm256_add_epi16(_mm256_mullo_epi16(s, a), _mm256_mullo_epi16(d, x));
+	x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+	return (_mm256_srli_epi16(_mm256_add_epi16(x, \
+	_mm256_srli_epi16(x, 8)), 8));
+}
+
+void	mlx_blend_chunk(uint8_t *dst, const uint8_t *src)
+{
+	__m256i			s;
+	__m256i			d;
+	__m256i			a;
+	const __m256i	zero = _mm256_setzero_si256();
+
+	s = _mm256_loadu_si256((const __m256i *)src);
+	a = _mm256_srli_epi32(s, 24);
+	if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, zero)) == -1)
+		return ;
+	d = _mm256_loadu_si256((const __m256i *)dst);
+	if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, \
+		_mm256_set1_epi32(255))) != -1)
+	{
+		a = _mm256_or_si256(a, _mm256_slli_epi32(a, 16));
+		s = _mm256_packus_epi16(mlx_blend_half(_mm256_unpacklo_epi8(s, zero), \
+		_mm256_unpacklo_epi8(d, zero), _mm256_unpacklo_epi32(a, a)), \
+		mlx_blend_half(_mm256_unpackhi_epi8(s, zero), \
+		_mm256_unpackhi_epi8(d, zero), _mm256_unpackhi_epi32(a, a)));
+	}
+	_mm256_storeu_si256((__m256i *)dst, s);
+}
+
+#elif defined(__SSE2__)
+
+static __m128i	mlx_blend_half(__m128i s, __m128i d, __m128i a)
+{
+	__m128i	x;
+
+	x = _mm_sub_epi16(_mm_set1_epi16(255), a);
+	x = _mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, x));
+	x = _mm_add_epi16(x, _mm_set1_epi16(128));
+	return (_mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8));
+}
+
+void	mlx_blend_chunk(uint8_t *dst, const uint8_t *src)
+{
+	__m128i			s;
+	__m128i			d;
+	__m128i			a;
+	const __m128i	zero = _mm_setzero_si128();
+
+	s = _mm_loadu_si128((const __m128i *)src);
+	a = _mm_srli_epi32(s, 24);
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, zero)) == 0xFFFF)
+		return ;
+	d = _mm_loadu_si128((const __m128i *)dst);
+	if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, _mm_set1_epi32(255))) != 0xFFFF)
+	{
+		a = _mm_or_si128(a, _mm_slli_epi32(a, 16));
+		s = _mm_packus_epi16(mlx_blend_half(_mm_unpacklo_epi8(s, zero), \
+		_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi32(a, a)), \
+		mlx_blend_half(_mm_unpackhi_epi8(s, zero), \
+		_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi32(a, a)));
+	}
+	_mm_storeu_si128((__m128i *)dst, s);
+}
+
+#else
+
+void	mlx_blend_chunk(uint8_t *dst, const uint8_t *src)
+{
+	mlx_blend_px(dst, src);
+}
+
+#endif
@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_cache.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/28 13:24:52 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/05 09:14:22 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <sys/stat.h>
+#include <errno.h>
+#include <unistd.h>
+
+/**
+ * Picks the directory of the program cache and creates it. That is
+ * MLX42_CACHE_DIR if set, otherwise mlx42 within XDG_CACHE_HOME or
+ * ~/.cache. Setting MLX42_CACHE_DIR to an empty string disables it, an
+ * empty XDG_CACHE_HOME is treated as unset like the XDG spec says.
+ * 
+ * @param dir Set to the directory.
+ * @return If the directory is available.
+ */
+static bool	mlx_cache_dir(char *dir)
+{
+	int32_t		len;
+	const char	*env = getenv("MLX42_CACHE_DIR");
+	const char	*xdg = getenv("XDG_CACHE_HOME");
+	const char	*home = getenv("HOME");
+
+	len = -1;
+	if (env)
+		len = snprintf(dir, MLX_CACHE_PATH, "%s", env);
+	else if (xdg && *xdg)
+		len = snprintf(dir, MLX_CACHE_PATH, "%s/mlx42", xdg);
+	else if (home)
+	{
+		snprintf(dir, MLX_CACHE_PATH, "%s/.cache", home);
+		mkdir(dir, 0755);
+		len = snprintf(dir, MLX_CACHE_PATH, "%s/.cache/mlx42", home);
+	}
+	if (len <= 0 || len >= MLX_CACHE_PATH - 32)
+		return (false);
+	return (mkdir(dir, 0755) == 0 || errno == EEXIST);
+}
+
+/**
+ * Writes a binary to a temporary file first and moves it in place after,
+ * so other processes never read a partially written binary.
+ */
+static void	mlx_cache_write(const char *path, t_mlx_cache_header *header, \
+const void *binary)
+{
+	FILE	*file;
+	char	temp[MLX_CACHE_FILE + 16];
+	bool	written;
+
+	snprintf(temp, sizeof(temp), "%s.%d", path, (int)getpid());
+	file = fopen(temp, "wb");
+	if (!file)
+		return ;
+	written = fwrite(header, sizeof(*header), 1, file) == 1 && \
+	fwrite(binary, 1, header->length, file) == header->length;
+	if (fclose(file) != 0 || !written || rename(temp, path) != 0)
+		remove(temp);
+}
+
+/**
+ * Enables the program cache if the driver can hand out program binaries,
+ * the entry points are only resolved once OpenGL is loaded.
+ * 
+ * @param mlxctx The MLX context.
+ */
+void	mlx_cache_init(t_mlx_ctx *mlxctx)
+{
+	GLint	formats;
+
+	formats = 0;
+	if (glfwExtensionSupported("GL_ARB_get_program_binary"))
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+	if (formats <= 0 || !mlx_cache_dir(mlxctx->cache.dir))
+		return ;
+	mlxctx->cache.get = \
+	(t_mlx_getbinary)glfwGetProcAddress("glGetProgramBinary");
+	mlxctx->cache.put = \
+	(t_mlx_putbinary)glfwGetProcAddress("glProgramBinary");
+	mlxctx->cache.hint = \
+	(t_mlx_programhint)glfwGetProcAddress("glProgramParameteri");
+	if (!mlxctx->cache.get || !mlxctx->cache.put || !mlxctx->cache.hint)
+	{
+		mlxctx->cache.get = NULL;
+		mlxctx->cache.hint = NULL;
+	}
+}
+
+/**
+ * Loads a program from the cache. Drivers reject binaries of another
+ * version or GPU, in which case the program has to be compiled again.
+ * 
+ * @param cache The program cache.
+ * @param path The file of the program within the cache.
+ * @param program The loaded program.
+ * @return If the program was cached and accepted by the driver.
+ */
+bool	mlx_cache_load(const t_mlx_cache *cache, const char *path, \
+GLuint *program)
+{
+	FILE				*file;
+	void				*binary;
+	GLint				success;
+	t_mlx_cache_header	header;
+
+	binary = NULL;
+	file = fopen(path, "rb");
+	if (!file)
+		return (false);
+	if (fread(&header, sizeof(header), 1, file) == 1 && \
+		header.magic == MLX_CACHE_MAGIC && header.length > 0)
+		binary = malloc(header.length);
+	success = binary && fread(binary, 1, header.length, file) == header.length;
+	fclose(file);
+	if (success)
+	{
+		*program = glCreateProgram();
+		cache->put(*program, header.format, binary, header.length);
+		glGetProgramiv(*program, GL_LINK_STATUS, &success);
+		if (!success)
+			glDeleteProgram(*program);
+	}
+	free(binary);
+	return (success);
+}
+
+/**
+ * Stores a freshly linked program in the cache, failing to do so only
+ * means it is compiled again next time.
+ * 
+ * @param cache The program cache.
+ * @param path The file of the program within the cache.
+ * @param program The linked program.
+ */
+void	mlx_cache_store(const t_mlx_cache *cache, const char *path, \
+GLuint program)
+{
+	void				*binary;
+	GLint				length;
+	t_mlx_cache_header	header;
+
+	length = 0;
+	binary = NULL;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length > 0)
+		binary = malloc(length);
+	if (!binary)
+		return ;
+	header = (t_mlx_cache_header){MLX_CACHE_MAGIC, 0, 0};
+	cache->get(program, length, &length, &header.format, binary);
+	header.length = length;
+	if (length > 0)
+		mlx_cache_write(path, &header, binary);
+	free(binary);
+}
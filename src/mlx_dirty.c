@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_dirty.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/18 11:02:37 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/18 11:02:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Checks wether two rectangles overlap or share an edge, in which case
+ * they can be merged without uploading many unmodified pixels.
+ */
+static bool	mlx_rect_touches(const t_mlx_rect *a, const t_mlx_rect *b)
+{
+	return (a->x <= b->x + b->w && b->x <= a->x + a->w && \
+	a->y <= b->y + b->h && b->y <= a->y + a->h);
+}
+
+// Grows the destination rectangle to the bounding box of both.
+static void	mlx_rect_merge(t_mlx_rect *dst, const t_mlx_rect *src)
+{
+	int32_t	x2;
+	int32_t	y2;
+
+	x2 = dst->x + dst->w;
+	if (src->x + src->w > x2)
+		x2 = src->x + src->w;
+	y2 = dst->y + dst->h;
+	if (src->y + src->h > y2)
+		y2 = src->y + src->h;
+	if (src->x < dst->x)
+		dst->x = src->x;
+	if (src->y < dst->y)
+		dst->y = src->y;
+	dst->w = x2 - dst->x;
+	dst->h = y2 - dst->y;
+}
+
+// Clips the rectangle to the bounds of the image, false if nothing is left.
+static bool	mlx_rect_clip(const t_mlx_image *img, t_mlx_rect *rect)
+{
+	if (rect->x < 0)
+	{
+		rect->w += rect->x;
+		rect->x = 0;
+	}
+	if (rect->y < 0)
+	{
+		rect->h += rect->y;
+		rect->y = 0;
+	}
+	if (rect->x + rect->w > img->width)
+		rect->w = img->width - rect->x;
+	if (rect->y + rect->h > img->height)
+		rect->h = img->height - rect->y;
+	return (rect->w > 0 && rect->h > 0);
+}
+
+/**
+ * Adds the given area to the dirty rectangles of the image.
+ * Touching rectangles are merged, once we run out of rectangles everything
+ * collapses into a single bounding box.
+ * 
+ * @param img The image that got modified.
+ * @param rect The modified area.
+ */
+void	mlx_dirty_add(t_mlx_image *img, t_mlx_rect rect)
+{
+	int32_t			i;
+	t_mlx_image_ctx	*imgctx;
+
+	if (!mlx_rect_clip(img, &rect))
+		return ;
+	i = -1;
+	imgctx = img->context;
+	imgctx->dirty = true;
+	while (++i < imgctx->rect_count)
+	{
+		if (mlx_rect_touches(&imgctx->rects[i], &rect))
+		{
+			mlx_rect_merge(&imgctx->rects[i], &rect);
+			return ;
+		}
+	}
+	if (imgctx->rect_count < MLX_DIRTY_RECTS)
+	{
+		imgctx->rects[imgctx->rect_count++] = rect;
+		return ;
+	}
+	while (--imgctx->rect_count > 0)
+		mlx_rect_merge(&imgctx->rects[0], &imgctx->rects[imgctx->rect_count]);
+	imgctx->rect_count = 1;
+	mlx_rect_merge(&imgctx->rects[0], &rect);
+}
+
+//= Exposed =//
+
+void	mlx_image_mark_dirty(t_mlx_image *img, uint16_t xy[2], uint16_t wh[2])
+{
+	if (!img || !xy || !wh)
+	{
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
+	}
+	mlx_dirty_add(img, (t_mlx_rect){xy[0], xy[1], wh[0], wh[1]});
+}
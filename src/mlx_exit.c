@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 02:43:22 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/14 11:50:17 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/04 13:02:44 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -23,12 +23,14 @@ void	mlx_delete_xpm42(t_xpm **xpm)
 	*xpm = NULL;
 }
 
-static void	mlx_free_imagedata(void	*content)
+static void	mlx_free_imagedata(t_mlx_image *img)
 {
-	t_mlx_image		*img;
-
-	img = content;
-	mlx_freen(3, img->context, img->pixels, img->instances);
+	free(((t_mlx_image_ctx *)img->context)->uploaded);
+	free(((t_mlx_image_ctx *)img->context)->islots);
+	free(((t_mlx_image_ctx *)img->context)->palette);
+	free(((t_mlx_image_ctx *)img->context)->stream);
+	mlx_free_pixels(img);
+	mlx_freen(3, img->context, img->instances, img);
 }
 
 void	mlx_quit(t_mlx *mlx)
@@ -38,15 +40,19 @@ void	mlx_quit(t_mlx *mlx)
 		mlx_log(MLX_WARNING, MLX_NULL_ARG);
 		return ;
 	}
-	glfwSetWindowShouldClose(mlx->window, true);
+	if (((t_mlx_ctx *)mlx->context)->software)
+		((t_mlx_ctx *)mlx->context)->closing = true;
+	else
+		glfwSetWindowShouldClose(mlx->window, true);
 }
 
 /**
  * All of glfw & glads resources are cleaned up by the terminate function.
- * Now its time to cleanup our own mess.
+ * Now its time to cleanup our own mess, every array is freed at once.
  */
 void	mlx_terminate(t_mlx *mlx)
 {
+	int32_t		i;
 	t_mlx_ctx	*mlxctx;
 
 	if (!mlx)
@@ -54,12 +60,20 @@ void	mlx_terminate(t_mlx *mlx)
 		mlx_log(MLX_WARNING, MLX_NULL_ARG);
 		return ;
 	}
-	if (!glfwWindowShouldClose(mlx->window))
-		glfwSetWindowShouldClose(mlx->window, true);
+	i = 0;
 	mlxctx = mlx->context;
-	glfwTerminate();
-	mlx_lstclear((t_mlx_list **)(&mlxctx->hooks), &free);
-	mlx_lstclear((t_mlx_list **)(&mlxctx->render_queue), &free);
-	mlx_lstclear((t_mlx_list **)(&mlxctx->images), &mlx_free_imagedata);
+	mlx_loader_stop(&mlxctx->loader);
+	if (!mlxctx->software)
+		glfwTerminate();
+	while (i < mlxctx->images.count)
+		mlx_free_imagedata(mlxctx->images.images[i++]);
+	mlx_free_tilemaps(mlxctx);
+	mlx_free_texts(mlxctx);
+	mlx_free_postprocess(mlxctx);
+	mlx_freen(5, mlxctx->images.images, mlxctx->images.slots, \
+	mlxctx->hooks, mlxctx->render_queue, mlxctx->layers);
+	mlx_free_materials(mlxctx);
+	mlx_freen(4, mlxctx->pages, mlxctx->batch.verts, mlxctx->batch.cmds, \
+	mlxctx->frame);
 	mlx_freen(2, mlxctx, mlx);
 }
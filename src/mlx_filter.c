@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_filter.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/26 18:15:37 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Sets the min & mag filter of the texture, only trilinear uses mipmaps.
+static void	mlx_filter_apply(GLuint texture, t_mlx_filter filter)
+{
+	const GLint	min[3] = {GL_NEAREST, GL_LINEAR, GL_LINEAR_MIPMAP_LINEAR};
+	const GLint	mag[3] = {GL_NEAREST, GL_LINEAR, GL_LINEAR};
+
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, min[filter]);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag[filter]);
+}
+
+/**
+ * Moves an image from the atlas onto a texture of its own, filtering would
+ * blend in the neighbouring sprites otherwise. The pixels are uploaded
+ * again before the next frame.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param img The image to move.
+ */
+static void	mlx_atlas_leave(t_mlx *mlx, t_mlx_image *img)
+{
+	t_mlx_image_ctx	*imgctx;
+
+	imgctx = img->context;
+	mlx_atlas_remove(mlx, img);
+	imgctx->texture = mlx_create_texture(img->width, img->height);
+	mlx_dirty_add(img, (t_mlx_rect){0, 0, img->width, img->height});
+}
+
+//= Exposed =//
+
+/**
+ * Images stay off the atlas after switching back to nearest, the texture
+ * of its own keeps working and there is no guarantee a spot is free.
+ */
+bool	mlx_image_set_filter(t_mlx *mlx, t_mlx_image *img, t_mlx_filter filter)
+{
+	t_mlx_image_ctx	*imgctx;
+
+	if (!mlx || !img)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (filter < MLX_FILTER_NEAREST || filter > MLX_FILTER_TRILINEAR)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	imgctx = img->context;
+	if (imgctx->palette && filter != MLX_FILTER_NEAREST)
+		return (mlx_log(MLX_WARNING, MLX_INDEXED));
+	imgctx->filter = filter;
+	if (imgctx->software)
+		return (true);
+	if (imgctx->page >= 0 && filter != MLX_FILTER_NEAREST)
+		mlx_atlas_leave(mlx, img);
+	mlx_filter_apply(imgctx->texture, filter);
+	if (filter == MLX_FILTER_TRILINEAR)
+		glGenerateMipmap(GL_TEXTURE_2D);
+	return (true);
+}
+
+bool	mlx_image_set_blend(t_mlx_image *img, t_mlx_blend blend)
+{
+	if (!img)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (blend < MLX_BLEND_ALPHA || blend > MLX_BLEND_OPAQUE)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	((t_mlx_image_ctx *)img->context)->blend = blend;
+	return (true);
+}
@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_headless.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/23 10:15:36 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/24 12:10:45 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Headless instances render into a framebuffer object of their own
+ * instead of a window, the window that holds the context is never shown.
+ * 
+ * No GPU is needed as long as a software implementation of OpenGL such as
+ * Mesa's llvmpipe is available, e.g: LIBGL_ALWAYS_SOFTWARE=1 under Xvfb.
+ */
+
+// Creates the offscreen color & depth targets that replace the window.
+static bool	mlx_create_target(t_mlx *mlx, t_mlx_ctx *mlxctx)
+{
+	glGenFramebuffers(1, &mlxctx->fbo);
+	glGenRenderbuffers(2, mlxctx->rbo);
+	glBindFramebuffer(GL_FRAMEBUFFER, mlxctx->fbo);
+	glBindRenderbuffer(GL_RENDERBUFFER, mlxctx->rbo[0]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, mlx->width, mlx->height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, \
+	GL_RENDERBUFFER, mlxctx->rbo[0]);
+	glBindRenderbuffer(GL_RENDERBUFFER, mlxctx->rbo[1]);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, \
+	mlx->width, mlx->height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, \
+	GL_RENDERBUFFER, mlxctx->rbo[1]);
+	glViewport(0, 0, mlx->width, mlx->height);
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+		return (mlx_log(MLX_ERROR, MLX_FRAMEBUFFER_FAILURE));
+	mlxctx->headless = true;
+	return (true);
+}
+
+// Flips the rows of the frame, OpenGL starts at the bottom left.
+static bool	mlx_flip_rows(uint8_t *pixels, int32_t width, int32_t height)
+{
+	int32_t			y;
+	uint8_t			*row;
+	const size_t	stride = width * sizeof(int32_t);
+
+	y = 0;
+	row = malloc(stride);
+	if (!row)
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	while (y < height / 2)
+	{
+		memcpy(row, &pixels[y * stride], stride);
+		memcpy(&pixels[y * stride], &pixels[(height - y - 1) * stride], stride);
+		memcpy(&pixels[(height - y - 1) * stride], row, stride);
+		y++;
+	}
+	free(row);
+	return (true);
+}
+
+//= Exposed =//
+
+t_mlx	*mlx_init_headless(int32_t width, int32_t height)
+{
+	t_mlx	*mlx;
+
+	if (!glfwInit())
+		return ((void *)mlx_log(MLX_ERROR, GLFW_INIT_FAILURE));
+	glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	mlx = mlx_init(width, height, "MLX42", false);
+	glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+	if (mlx && !mlx_create_target(mlx, mlx->context))
+	{
+		mlx_terminate(mlx);
+		return (NULL);
+	}
+	return (mlx);
+}
+
+void	mlx_set_frame_limit(t_mlx *mlx, uint32_t frames)
+{
+	if (!mlx)
+	{
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
+	}
+	((t_mlx_ctx *)mlx->context)->frame_limit = frames;
+	((t_mlx_ctx *)mlx->context)->frames = 0;
+}
+
+bool	mlx_read_frame(t_mlx *mlx, uint8_t *pixels)
+{
+	const t_mlx_ctx	*mlxctx;
+
+	if (!mlx || !pixels)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	mlxctx = mlx->context;
+	if (mlxctx->software)
+		return (memcpy(pixels, mlxctx->frame, \
+		mlx->width * mlx->height * sizeof(int32_t)), true);
+	if (!mlxctx->headless)
+		return (mlx_log(MLX_WARNING, MLX_NOT_HEADLESS));
+	glBindFramebuffer(GL_READ_FRAMEBUFFER, mlxctx->fbo);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(0, 0, mlx->width, mlx->height, GL_RGBA, GL_UNSIGNED_BYTE, \
+	pixels);
+	return (mlx_flip_rows(pixels, mlx->width, mlx->height));
+}
@@ -6,144 +6,132 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/01/21 15:34:45 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/14 14:36:50 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/03 16:02:11 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "MLX42/MLX42_Int.h"
 
-// Reference: https://bit.ly/3KuHOu1 (Matrix View Projection)
-static void	mlx_draw_texture(t_mlx *mlx, t_mlx_image *img, uint8_t *pixels, \
-t_vert *vertices)
+// Releases the texture and buffers of an image, along with its memory.
+static void	mlx_free_image(t_mlx *mlx, t_mlx_image *image)
 {
-	t_mlx_ctx		*mlxctx;
-	const int32_t	w = img->width;
-	const int32_t	h = img->height;
-	const float		matrix[16] = {
-		2.f / mlx->width, 0, 0, 0,
-		0, 2. / -mlx->height, 0, 0,
-		0, 0, -2. / (1000. - -1000.), 0,
-		-1, -(mlx->height / -mlx->height),
-		-((1000. + -1000.) / (1000. - -1000.)), 1
-	};
+	t_mlx_image_ctx	*imgctx;
 
-	mlxctx = mlx->context;
-	glUseProgram(mlxctx->shaderprogram);
-	glUniformMatrix4fv(glGetUniformLocation(mlxctx->shaderprogram, \
-	"ProjMatrix"), 1, GL_FALSE, matrix);
-	glUniform1i(glGetUniformLocation(mlxctx->shaderprogram, "OutTexture"), 0);
-	glBindVertexArray(mlxctx->vao);
-	glBindBuffer(GL_ARRAY_BUFFER, mlxctx->vbo);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(t_vert) * 6, vertices, \
-	GL_STATIC_DRAW);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, \
-	GL_UNSIGNED_BYTE, pixels);
-	glDrawArrays(GL_TRIANGLES, 0, 6);
+	imgctx = image->context;
+	if (imgctx->page >= 0)
+		mlx_atlas_remove(mlx, image);
+	else if (!imgctx->software)
+		glDeleteTextures(1, &imgctx->texture);
+	if (!imgctx->software)
+		glDeleteBuffers(1, &imgctx->instance_vbo);
+	if (!imgctx->software && imgctx->palette)
+		glDeleteTextures(1, &imgctx->palette_tex);
+	mlx_stream_free(imgctx);
+	mlx_free_pixels(image);
+	mlx_freen(3, imgctx->uploaded, imgctx->islots, imgctx->palette);
+	mlx_freen(2, image->instances, image->context);
 }
 
 /**
- * Internal function to draw a single instance of an image
- * to the screen.
+ * Allocates an image with the given amount of bytes per pixel and adds it
+ * to the slot map, its texture is left to the caller.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param width The width of the image.
+ * @param height The height of the image.
+ * @param bpp The bytes per pixel, 4 for RGBA or 1 for indexed images.
+ * @return The image, NULL on failure.
  */
-void	mlx_draw_instance(t_mlx *mlx, t_mlx_image *img, \
-t_mlx_instance *instance)
+t_mlx_image	*mlx_image_alloc(t_mlx *mlx, uint16_t width, uint16_t height, \
+uint8_t bpp)
 {
-	t_mlx_image_ctx	*imgctx;
-	const int32_t	w = img->width;
-	const int32_t	h = img->height;	
-	const int32_t	x = instance->x;
-	const int32_t	y = instance->y;
+	t_mlx_image		*newimg;
+	t_mlx_image_ctx	*newctx;
+	t_mlx_ctx		*mlxctx;
 
-	imgctx = img->context;
-	imgctx->vertices[0] = (t_vert){x, y, instance->z, 0.f, 0.f};
-	imgctx->vertices[1] = (t_vert){x + w, y + h, instance->z, 1.f, 1.f};
-	imgctx->vertices[2] = (t_vert){x + w, y, instance->z, 1.f, 0.f};
-	imgctx->vertices[3] = (t_vert){x, y, instance->z, 0.f, 0.f};
-	imgctx->vertices[4] = (t_vert){x, y + h, instance->z, 0.f, 1.f};
-	imgctx->vertices[5] = (t_vert){x + w, y + h, instance->z, 1.f, 1.f};
-	glActiveTexture(GL_TEXTURE0);
-	glBindTexture(GL_TEXTURE_2D, imgctx->texture);
-	mlx_draw_texture(mlx, img, img->pixels, imgctx->vertices);
+	mlxctx = mlx->context;
+	newimg = calloc(1, sizeof(t_mlx_image));
+	newctx = calloc(1, sizeof(t_mlx_image_ctx));
+	if (!newimg || !newctx)
+		return ((void *)mlx_freen(2, newimg, newctx));
+	(*(uint16_t *)&newimg->width) = width;
+	(*(uint16_t *)&newimg->height) = height;
+	newimg->context = newctx;
+	newimg->pixels = calloc(width * height, bpp);
+	if (!newimg->pixels || !mlx_slot_insert(&mlxctx->images, newimg))
+		return ((void *)mlx_freen(3, newimg->pixels, newimg, newctx));
+	newctx->page = -1;
+	newctx->bpp = bpp;
+	newctx->format = GL_RGBA;
+	newctx->software = mlxctx->software;
+	if (!newctx->software)
+		glGenBuffers(1, &newctx->instance_vbo);
+	mlx_dirty_add(newimg, (t_mlx_rect){0, 0, width, height});
+	newimg->enabled = true;
+	return (newimg);
 }
 
 //= Exposed =//
 
-t_mlx_image	*mlx_image_to_window(t_mlx *mlx, t_mlx_image *img, int32_t x, \
+int32_t	mlx_image_to_window(t_mlx *mlx, t_mlx_image *img, int32_t x, \
 int32_t y)
 {
 	int32_t			index;
 	t_mlx_ctx		*mlxctx;
-	t_mlx_instance	*temp;
-	t_draw_queue	*queue;
+	t_mlx_image_ctx	*imgctx;
 
 	if (!mlx || !img)
-		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
-	mlxctx = mlx->context;
-	temp = realloc(img->instances, (++img->count) * sizeof(t_mlx_instance));
-	queue = malloc(sizeof(t_draw_queue));
-	if (!temp || !queue)
 	{
-		mlx_log(MLX_ERROR, MLX_MEMORY_FAIL);
-		return ((void *)mlx_freen(2, temp, queue));
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return (-1);
 	}
-	index = img->count - 1;
-	img->instances = temp;
-	img->instances[index].x = x;
-	img->instances[index].y = y;
-	img->instances[index].z = 0;
-	queue->image = img;
-	queue->instance = &img->instances[index];
-	mlx_lstadd_back(&mlxctx->render_queue, mlx_lstnew(queue));
-	return (img);
+	mlxctx = mlx->context;
+	imgctx = img->context;
+	if (!mlx_grow((void **)&mlxctx->render_queue, &mlxctx->queue_cap, \
+		mlxctx->queue_count + 1, sizeof(t_draw_queue)))
+		return (-1);
+	index = mlx_instance_new(img, imgctx);
+	if (index < 0)
+		return (-1);
+	img->instances[index] = (t_mlx_instance){x, y, 0, true, {1.f, 1.f}, 0.f, \
+	{0, 0, 0, 0}, {255, 255, 255, 255}};
+	mlxctx->render_queue[mlxctx->queue_count++] = (t_draw_queue){img, \
+	imgctx->handle, index, imgctx->islots[index].generation};
+	return (index);
 }
 
 t_mlx_image	*mlx_new_image(t_mlx *mlx, uint16_t width, uint16_t height)
 {
 	t_mlx_image		*newimg;
 	t_mlx_image_ctx	*newctx;
-	const t_mlx_ctx	*mlxctx = mlx->context;
 
-	newimg = calloc(1, sizeof(t_mlx_image));
-	newctx = calloc(1, sizeof(t_mlx_image_ctx));
-	if (!newimg || !newctx)
-		return ((void *)mlx_freen(2, newimg, newctx));
-	(*(uint16_t *)&newimg->width) = width;
-	(*(uint16_t *)&newimg->height) = height;
-	newimg->context = newctx;
-	newimg->pixels = calloc(width * height, sizeof(int32_t));
-	if (!newimg->pixels)
-		return ((void *)mlx_freen(2, newimg, newctx));
-	glGenTextures(1, &newctx->texture);
-	glBindTexture(GL_TEXTURE_2D, newctx->texture);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, \
-	GL_UNSIGNED_BYTE, newimg->pixels);
-	mlx_lstadd_back((t_mlx_list **)(&mlxctx->images), mlx_lstnew(newimg));
-	return (newimg->enabled = true, newimg);
+	newimg = mlx_image_alloc(mlx, width, height, sizeof(int32_t));
+	if (!newimg)
+		return (NULL);
+	newctx = newimg->context;
+	if (!newctx->software && !mlx_atlas_insert(mlx, newimg))
+		newctx->texture = mlx_create_texture(width, height);
+	return (newimg);
 }
 
+/**
+ * Removing an image from the slot map is O(1), any of its entries in the
+ * render queue are left as is and get dropped before the next frame.
+ */
 void	mlx_delete_image(t_mlx *mlx, t_mlx_image *image)
 {
-	t_mlx_list		*imglst;
-	t_mlx_list		*quelst;
 	t_mlx_ctx		*mlxctx;
 
-	mlxctx = mlx->context;
-	imglst = mlx_lstremove(&mlxctx->images, image, &mlx_equal_image);
-	if (imglst)
-	{
-		glDeleteTextures(1, &((t_mlx_image_ctx *)image->context)->texture);
-		mlx_freen(3, image->pixels, image->instances, image->context);
-		free(imglst);
-	}
-	quelst = mlx_lstremove(&mlxctx->render_queue, image, &mlx_equal_inst);
-	if (quelst)
+	if (!mlx || !image)
 	{
-		free(quelst->content);
-		free(quelst);
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
 	}
+	mlxctx = mlx->context;
+	mlx_slot_remove(&mlxctx->images, \
+	((t_mlx_image_ctx *)image->context)->handle);
+	if (image->count > 0)
+		mlxctx->queue_stale = true;
+	mlx_free_image(mlx, image);
 	free(image);
 }
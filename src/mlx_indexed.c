@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_indexed.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 10:21:44 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 13:52:06 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Creates the single channel texture that holds the palette indices.
+ * Its rows are rarely 4 byte aligned, so uploads use byte alignment.
+ */
+static GLuint	mlx_create_index_texture(int32_t width, int32_t height)
+{
+	GLuint	texture;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, \
+	GL_UNSIGNED_BYTE, NULL);
+	return (texture);
+}
+
+/**
+ * Binds the palette of an indexed image to the second texture unit and
+ * tells the fragment shader to look up the colors, NULL for RGBA images.
+ * The uniform is only updated when switching between the two.
+ * 
+ * @param mlxctx The MLX context.
+ * @param imgctx The context of the image about to be drawn, or NULL.
+ */
+void	mlx_palette_bind(t_mlx_ctx *mlxctx, const t_mlx_image_ctx *imgctx)
+{
+	const bool	indexed = imgctx && imgctx->palette;
+
+	if (mlxctx->indexed != indexed)
+		glUniform1i(mlxctx->indexed_loc, indexed);
+	mlxctx->indexed = indexed;
+	if (!indexed)
+		return ;
+	glActiveTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, imgctx->palette_tex);
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+ * Uploads the palette of an indexed image after it was changed.
+ * 
+ * @param imgctx The context of the indexed image.
+ * @return The amount of bytes uploaded.
+ */
+size_t	mlx_palette_upload(t_mlx_image_ctx *imgctx)
+{
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+	glBindTexture(GL_TEXTURE_2D, imgctx->palette_tex);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, MLX_PALETTE_SIZE, 1, GL_RGBA, \
+	GL_UNSIGNED_BYTE, imgctx->palette);
+	imgctx->palette_dirty = false;
+	return (MLX_PALETTE_SIZE * sizeof(int32_t));
+}
+
+//= Exposed =//
+
+t_mlx_image	*mlx_new_indexed_image(t_mlx *mlx, uint16_t width, \
+uint16_t height)
+{
+	t_mlx_image		*newimg;
+	t_mlx_image_ctx	*newctx;
+
+	if (!mlx)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	newimg = mlx_image_alloc(mlx, width, height, sizeof(uint8_t));
+	if (!newimg)
+		return (NULL);
+	newctx = newimg->context;
+	newctx->palette = calloc(MLX_PALETTE_SIZE, sizeof(int32_t));
+	if (!newctx->palette)
+	{
+		mlx_delete_image(mlx, newimg);
+		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	newctx->format = GL_RED;
+	newctx->palette_dirty = true;
+	if (newctx->software)
+		return (newimg);
+	newctx->texture = mlx_create_index_texture(width, height);
+	newctx->palette_tex = mlx_create_texture(MLX_PALETTE_SIZE, 1);
+	return (newimg);
+}
+
+bool	mlx_set_palette(t_mlx_image *img, const uint32_t *colors, \
+uint16_t start, uint16_t count)
+{
+	int32_t			i;
+	t_mlx_image_ctx	*imgctx;
+
+	if (!img || !colors)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	imgctx = img->context;
+	if (!imgctx->palette || start + count > MLX_PALETTE_SIZE)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	i = -1;
+	while (++i < count)
+		mlx_draw_pixel(&imgctx->palette[(start + i) * sizeof(int32_t)], \
+		colors[i]);
+	imgctx->palette_dirty = true;
+	return (true);
+}
@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 00:24:30 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/02 12:28:01 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/05 09:40:03 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -18,57 +18,82 @@ static void	framebuffer_callback(GLFWwindow *window, int width, int height)
 	glViewport(0, 0, width, height);
 }
 
+/**
+ * Only on resize the window size and projection matrix get updated. A
+ * minimized window reports a size of 0, the last valid size is kept.
+ */
+static void	resize_callback(GLFWwindow *window, int width, int height)
+{
+	if (width <= 0 || height <= 0)
+		return ;
+	mlx_update_matrix(glfwGetWindowUserPointer(window), width, height);
+}
+
+/**
+ * Every image is drawn as a scaled instance of the same unit quad, so the
+ * vertex buffer is filled once. Attributes 2 to 5 hold the location,
+ * transform, source rectangle and tint of an instance, they advance once
+ * per instance and are pointed at the instance buffer of an image when it
+ * gets drawn, see mlx_instance_attribs.
+ */
 static bool	mlx_create_buffers(t_mlx *mlx)
 {
 	t_mlx_ctx		*context;
+	const t_vert	quad[6] = {
+	{0, 0, 0, 0, 0, {0}}, {1, 1, 0, 1, 1, {0}}, {1, 0, 0, 1, 0, {0}},
+	{0, 0, 0, 0, 0, {0}}, {0, 1, 0, 0, 1, {0}}, {1, 1, 0, 1, 1, {0}}
+	};
 
 	context = mlx->context;
+	mlx_batch_init(&context->batch);
 	glGenVertexArrays(1, &(context->vao));
 	glGenBuffers(1, &(context->vbo));
 	glBindVertexArray(context->vao);
 	glBindBuffer(GL_ARRAY_BUFFER, context->vbo);
+	glBufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_STATIC_DRAW);
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(t_vert), NULL);
 	glEnableVertexAttribArray(0);
 	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(t_vert), \
 	(void *)(sizeof(float) * 3));
 	glEnableVertexAttribArray(1);
+	mlx_instance_layout();
 	glEnable(GL_DEPTH_TEST);
 	glEnable(GL_BLEND);
 	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 	return (true);
 }
 
-// TODO: Fix relative to absolute, in some cases fopen just fails on some OS.
-static bool	mlx_init_render(t_mlx *mlx)
+/**
+ * Creates the window, sets up OpenGL for it and records how long starting
+ * took. The shaders are built into the library, so no files are read.
+ */
+static bool	mlx_init_render(t_mlx *mlx, const char *title, double start)
 {
-	uint32_t	s[3];
-
+	mlx->window = glfwCreateWindow(mlx->width, mlx->height, title, NULL, NULL);
 	if (!mlx->window)
 		return (mlx_log(MLX_ERROR, GLFW_WIN_FAILURE));
 	glfwMakeContextCurrent(mlx->window);
 	glfwSetFramebufferSizeCallback(mlx->window, framebuffer_callback);
+	glfwSetWindowSizeCallback(mlx->window, resize_callback);
 	glfwSetWindowUserPointer(mlx->window, mlx);
 	glfwSwapInterval(MLX_SWAP_INTERVAL);
-	{
-		if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
-			return (mlx_log(MLX_ERROR, GLFW_GLAD_FAILURE));
-		if (!mlx_compile_shader(VERTEX_PATH, GL_VERTEX_SHADER, &s[0]) || \
-			!mlx_compile_shader(FRAGMENT_PATH, GL_FRAGMENT_SHADER, &s[1]))
-			return (mlx_log(MLX_ERROR, MLX_SHADER_FAILURE));
-	}
-	s[2] = 0;
-	if (!mlx_init_shaders(mlx, s))
+	if (!gladLoadGLLoader((GLADloadproc)glfwGetProcAddress))
+		return (mlx_log(MLX_ERROR, GLFW_GLAD_FAILURE));
+	if (!mlx_init_shaders(mlx))
 		return (false);
-	glDeleteShader(s[0]);
-	glDeleteShader(s[1]);
-	glUseProgram(((t_mlx_ctx *)mlx->context)->shaderprogram);
-	return (mlx_create_buffers(mlx));
+	mlx_update_matrix(mlx, mlx->width, mlx->height);
+	if (!mlx_create_buffers(mlx))
+		return (false);
+	((t_mlx_ctx *)mlx->context)->stats.startup = mlx_software_time() - start;
+	return (true);
 }
 
 t_mlx	*mlx_init(int32_t Width, int32_t Height, const char *Title, bool Resize)
 {
-	t_mlx		*mlx;
-	const bool	init = glfwInit();
+	t_mlx			*mlx;
+	const double	start = mlx_software_time();
+	const bool		init = glfwInit();
 
 	mlx = calloc(1, sizeof(t_mlx));
 	if (!mlx || !init)
@@ -84,9 +109,8 @@ t_mlx	*mlx_init(int32_t Width, int32_t Height, const char *Title, bool Resize)
 	glfwWindowHint(GLFW_RESIZABLE, Resize);
 	mlx->width = Width;
 	mlx->height = Height;
-	mlx->window = glfwCreateWindow(Width, Height, Title, NULL, NULL);
 	mlx->context = calloc(1, sizeof(t_mlx_ctx));
-	if (!mlx->context || !mlx_init_render(mlx))
+	if (!mlx->context || !mlx_init_render(mlx, Title, start))
 	{
 		free(mlx);
 		return ((void *)mlx_log(MLX_ERROR, MLX_RENDER_FAILURE));
@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_instance.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/26 14:08:21 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Hands out the index for a new instance, removed instances are reused
+ * first, else the arrays grow geometrically so adding stays O(1).
+ * 
+ * @param img The image to add an instance to.
+ * @param imgctx The context of the image.
+ * @return The index of the instance, -1 on failure.
+ */
+int32_t	mlx_instance_new(t_mlx_image *img, t_mlx_image_ctx *imgctx)
+{
+	int32_t	index;
+
+	if (imgctx->free_instance)
+	{
+		index = imgctx->free_instance - 1;
+		imgctx->free_instance = imgctx->islots[index].next;
+		imgctx->islots[index].removed = false;
+		return (index);
+	}
+	if (img->count >= INT32_MAX)
+	{
+		mlx_log(MLX_WARNING, MLX_INSTANCE_LIMIT);
+		return (-1);
+	}
+	if (!mlx_grow((void **)&img->instances, &imgctx->instance_cap, \
+		img->count + 1, sizeof(t_mlx_instance)) || \
+		!mlx_grow((void **)&imgctx->islots, &imgctx->islot_cap, \
+		img->count + 1, sizeof(t_mlx_islot)))
+		return (-1);
+	imgctx->islots[img->count] = (t_mlx_islot){0, 0, false};
+	return (img->count++);
+}
+
+/**
+ * Checks if a render queue entry still refers to a living instance,
+ * the image has to be checked against the slot map before this.
+ * 
+ * @param entry The render queue entry.
+ * @return Wether the instance was not removed since the entry was made.
+ */
+bool	mlx_instance_valid(const t_draw_queue *entry)
+{
+	const t_mlx_image_ctx	*imgctx = entry->image->context;
+
+	return (imgctx->islots[entry->instance].generation == entry->generation);
+}
+
+/**
+ * Internal function to draw a contiguous range of instances of an image
+ * to the screen, using a single instanced draw call.
+ * 
+ * The unit quad is static, each instance carries its own location and
+ * transform which are read from the instance buffer starting at the given
+ * instance.
+ * Images on the atlas map the quad onto their area of the page.
+ */
+void	mlx_draw_instances(t_mlx *mlx, t_mlx_image *img, int32_t start, \
+int32_t count)
+{
+	t_mlx_ctx		*mlxctx;
+	t_mlx_image_ctx	*imgctx;
+	float			quad[6];
+
+	mlxctx = mlx->context;
+	imgctx = img->context;
+	mlx_set_state(mlxctx, imgctx->material, imgctx->blend);
+	quad[0] = img->width;
+	quad[1] = img->height;
+	quad[2] = imgctx->atlas[0] / (float)MLX_ATLAS_SIZE;
+	quad[3] = imgctx->atlas[1] / (float)MLX_ATLAS_SIZE;
+	quad[4] = img->width / (float)MLX_ATLAS_SIZE;
+	quad[5] = img->height / (float)MLX_ATLAS_SIZE;
+	if (imgctx->page < 0)
+		memcpy(&quad[2], (float [4]){0.f, 0.f, 1.f, 1.f}, 4 * sizeof(float));
+	mlx_set_quad(mlxctx, quad);
+	mlx_palette_bind(mlxctx, imgctx);
+	glBindVertexArray(mlxctx->vao);
+	glBindTexture(GL_TEXTURE_2D, imgctx->texture);
+	glBindBuffer(GL_ARRAY_BUFFER, imgctx->instance_vbo);
+	mlx_instance_attribs(start);
+	glDrawArraysInstanced(GL_TRIANGLES, 0, 6, count);
+	mlxctx->stats.counts.draw_calls++;
+	mlxctx->stats.counts.instances += count;
+}
+
+//= Exposed =//
+
+/**
+ * Removing is O(1), the entry in the render queue is dropped before the
+ * next frame just like those of deleted images.
+ */
+bool	mlx_remove_instance(t_mlx *mlx, t_mlx_image *img, int32_t instance)
+{
+	t_mlx_image_ctx	*imgctx;
+	t_mlx_islot		*islot;
+
+	if (!mlx || !img)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	imgctx = img->context;
+	if (instance < 0 || (uint32_t)instance >= img->count || \
+		imgctx->islots[instance].removed)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	islot = &imgctx->islots[instance];
+	img->instances[instance].enabled = false;
+	islot->removed = true;
+	islot->generation++;
+	islot->next = imgctx->free_instance;
+	imgctx->free_instance = instance + 1;
+	((t_mlx_ctx *)mlx->context)->queue_stale = true;
+	return (true);
+}
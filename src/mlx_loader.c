@@ -0,0 +1,147 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_loader.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/01 15:26:03 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 11:46:20 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include "lodepng.h"
+
+/**
+ * Decodes the file of a job into its texture, runs on a worker thread.
+ * 
+ * @param job The job.
+ * @return If the file could be decoded.
+ */
+static bool	mlx_loader_decode(t_mlx_job *job)
+{
+	t_xpm		*xpm;
+	uint32_t	size[2];
+
+	if (strstr(job->path, ".xpm42"))
+	{
+		xpm = mlx_load_xpm42(job->path);
+		if (!xpm)
+			return (false);
+		job->texture = xpm->texture;
+		free(xpm);
+		return (true);
+	}
+	if (lodepng_decode32_file(&job->texture.pixels, &size[0], &size[1], \
+		job->path))
+		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	job->texture.width = size[0];
+	job->texture.height = size[1];
+	job->texture.bytes_per_pixel = sizeof(int32_t);
+	return (size[0] <= UINT16_MAX && size[1] <= UINT16_MAX);
+}
+
+/**
+ * The main function of a worker, it decodes queued jobs until the loader
+ * stops. Jobs that are still queued by then are never decoded.
+ */
+static void	*mlx_loader_work(void *arg)
+{
+	t_mlx_job		*job;
+	t_mlx_loader	*loader;
+
+	loader = arg;
+	pthread_mutex_lock(&loader->lock);
+	while (!loader->stop)
+	{
+		job = loader->queue;
+		if (!job)
+			pthread_cond_wait(&loader->wake, &loader->lock);
+		else
+		{
+			loader->queue = job->next;
+			if (!loader->queue)
+				loader->queue_tail = NULL;
+			pthread_mutex_unlock(&loader->lock);
+			job->decoded = mlx_loader_decode(job);
+			pthread_mutex_lock(&loader->lock);
+			job->next = loader->done;
+			loader->done = job;
+		}
+	}
+	pthread_mutex_unlock(&loader->lock);
+	return (NULL);
+}
+
+/**
+ * Starts the workers. Decoding keeps its tables and pixels on the heap,
+ * so the default stack size of a thread is plenty on every platform.
+ */
+static bool	mlx_loader_start(t_mlx_loader *loader)
+{
+	if (pthread_mutex_init(&loader->lock, NULL))
+		return (mlx_log(MLX_ERROR, MLX_THREAD_FAILURE));
+	pthread_cond_init(&loader->wake, NULL);
+	while (loader->thread_count < MLX_LOAD_THREADS && \
+		!pthread_create(&loader->threads[loader->thread_count], NULL, \
+		&mlx_loader_work, loader))
+		loader->thread_count++;
+	if (loader->thread_count > 0)
+		return (true);
+	pthread_cond_destroy(&loader->wake);
+	pthread_mutex_destroy(&loader->lock);
+	return (mlx_log(MLX_ERROR, MLX_THREAD_FAILURE));
+}
+
+/**
+ * Queues a new job for the workers, which are woken up if they are idle.
+ * 
+ * @param loader The loader.
+ * @param path The file to load.
+ * @param func The function to receive the image.
+ * @param param The parameter to pass onto the function.
+ * @return If there was enough memory for the job.
+ */
+static bool	mlx_loader_push(t_mlx_loader *loader, const char *path, \
+t_mlx_loadfunc func, void *param)
+{
+	t_mlx_job	*job;
+
+	job = calloc(1, sizeof(t_mlx_job));
+	if (job)
+		job->path = strdup(path);
+	if (!job || !job->path)
+	{
+		free(job);
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	job->func = func;
+	job->param = param;
+	pthread_mutex_lock(&loader->lock);
+	if (loader->queue_tail)
+		loader->queue_tail->next = job;
+	else
+		loader->queue = job;
+	loader->queue_tail = job;
+	pthread_cond_signal(&loader->wake);
+	pthread_mutex_unlock(&loader->lock);
+	return (true);
+}
+
+//= Exposed =//
+
+bool	mlx_load_async(t_mlx *mlx, const char *path, t_mlx_loadfunc func, \
+void *param)
+{
+	t_mlx_loader	*loader;
+
+	if (!mlx || !path || !func)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (!strstr(path, ".xpm42") && !strstr(path, ".png"))
+		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE_EXT));
+	loader = &((t_mlx_ctx *)mlx->context)->loader;
+	if (loader->thread_count == 0 && !mlx_loader_start(loader))
+		return (false);
+	return (mlx_loader_push(loader, path, func, param));
+}
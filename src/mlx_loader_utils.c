@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_loader_utils.c                                 :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/01 15:26:03 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 15:26:03 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Stops and joins the workers, whatever they were working on is dropped.
+ * Images that were still being uploaded stay around until terminated.
+ * 
+ * @param loader The loader.
+ */
+void	mlx_loader_stop(t_mlx_loader *loader)
+{
+	int32_t	i;
+
+	if (loader->thread_count == 0)
+		return ;
+	i = 0;
+	pthread_mutex_lock(&loader->lock);
+	loader->stop = true;
+	pthread_cond_broadcast(&loader->wake);
+	pthread_mutex_unlock(&loader->lock);
+	while (i < loader->thread_count)
+		pthread_join(loader->threads[i++], NULL);
+	mlx_free_jobs(loader->queue);
+	mlx_free_jobs(loader->done);
+	mlx_free_jobs(loader->finishing);
+	pthread_cond_destroy(&loader->wake);
+	pthread_mutex_destroy(&loader->lock);
+	loader->thread_count = 0;
+}
+
+// Releases a list of jobs, pixels handed over to an image are kept.
+void	mlx_free_jobs(t_mlx_job *job)
+{
+	t_mlx_job	*next;
+
+	while (job)
+	{
+		next = job->next;
+		mlx_freen(3, job->path, job->texture.pixels, job);
+		job = next;
+	}
+}
+
+/**
+ * Creates the image of a decoded job and hands it the decoded pixels,
+ * nothing is marked for upload yet.
+ */
+static bool	mlx_job_image(t_mlx *mlx, t_mlx_job *job)
+{
+	t_mlx_image_ctx	*imgctx;
+
+	job->image = mlx_new_image(mlx, job->texture.width, job->texture.height);
+	if (!job->image)
+		return (false);
+	free(job->image->pixels);
+	job->image->pixels = job->texture.pixels;
+	job->texture.pixels = NULL;
+	imgctx = job->image->context;
+	imgctx->dirty = false;
+	imgctx->rect_count = 0;
+	return (true);
+}
+
+/**
+ * Marks the next rows of the image for upload, as many as fit into the
+ * budget but at least one so every job makes progress. The image is
+ * created first, if that fails the job is finished as if it failed.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param job The job.
+ * @param budget The bytes that may still be uploaded this frame.
+ * @return The bytes marked for upload.
+ */
+static int64_t	mlx_job_upload(t_mlx *mlx, t_mlx_job *job, int64_t budget)
+{
+	int64_t	rows;
+	int64_t	stride;
+
+	if (!job->image && !mlx_job_image(mlx, job))
+	{
+		job->decoded = false;
+		return (0);
+	}
+	stride = job->image->width * sizeof(int32_t);
+	rows = job->image->height - job->row;
+	if (stride > 0 && budget / stride < rows)
+		rows = budget / stride;
+	if (rows < 1)
+		rows = 1;
+	mlx_dirty_add(job->image, (t_mlx_rect){0, job->row, job->image->width, \
+	rows});
+	job->row += rows;
+	return (rows * stride);
+}
+
+/**
+ * Finishes the decoded jobs on the main thread, within the upload budget
+ * of a frame. A finished job passes its image on to the callback, which
+ * gets NULL if the file could not be loaded.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_loader_update(t_mlx *mlx)
+{
+	int64_t			budget;
+	t_mlx_job		*job;
+	t_mlx_loader	*loader;
+
+	loader = &((t_mlx_ctx *)mlx->context)->loader;
+	if (!loader->finishing && loader->thread_count > 0)
+	{
+		pthread_mutex_lock(&loader->lock);
+		loader->finishing = loader->done;
+		loader->done = NULL;
+		pthread_mutex_unlock(&loader->lock);
+	}
+	budget = MLX_LOAD_BUDGET;
+	while (loader->finishing && budget > 0)
+	{
+		job = loader->finishing;
+		if (job->decoded)
+			budget -= mlx_job_upload(mlx, job, budget);
+		if (!job->decoded || job->row >= job->image->height)
+		{
+			loader->finishing = job->next;
+			job->func(job->image, job->param);
+			mlx_freen(3, job->path, job->texture.pixels, job);
+		}
+	}
+}
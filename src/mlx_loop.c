@@ -6,47 +6,37 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 01:24:36 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/10 17:51:09 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/01 15:26:03 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "MLX42/MLX42_Int.h"
 
+// Hooks may add hooks, so the array is indexed again on every call.
 static void	mlx_exec_loop_hooks(t_mlx *mlx)
 {
-	t_mlx_list		*lstcpy;
-	t_mlx_hook		*hook;
+	int32_t			i;
 	const t_mlx_ctx	*mlxctx = mlx->context;
 
-	lstcpy = mlxctx->hooks;
-	while (lstcpy)
+	i = 0;
+	while (i < mlxctx->hook_count)
 	{
-		hook = ((t_mlx_hook *)lstcpy->content);
-		hook->func(hook->param);
-		lstcpy = lstcpy->next;
+		mlxctx->hooks[i].func(mlxctx->hooks[i].param);
+		i++;
 	}
 }
 
 bool	mlx_loop_hook(t_mlx *mlx, void (*f)(void *), void *param)
 {
-	t_mlx_list		*lst;
-	t_mlx_hook		*hook;
-	const t_mlx_ctx	*mlxctx = mlx->context;
+	t_mlx_ctx	*mlxctx;
 
 	if (!mlx || !f)
 		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
-	hook = malloc(sizeof(t_mlx_hook));
-	if (!hook)
-		return (false);
-	hook->func = f;
-	hook->param = param;
-	lst = mlx_lstnew(hook);
-	if (!lst)
-	{
-		free(hook);
+	mlxctx = mlx->context;
+	if (!mlx_grow((void **)&mlxctx->hooks, &mlxctx->hook_cap, \
+		mlxctx->hook_count + 1, sizeof(t_mlx_hook)))
 		return (false);
-	}
-	mlx_lstadd_back((t_mlx_list **)(&mlxctx->hooks), lst);
+	mlxctx->hooks[mlxctx->hook_count++] = (t_mlx_hook){param, f};
 	return (true);
 }
 
@@ -69,20 +59,19 @@ static bool	mlx_handle_resize(t_mlx *mlx, t_mlx_image *img)
 }
 */
 
-static void	mlx_render_images(t_mlx *mlx)
+/**
+ * The loop ends once the window should close or, if a frame limit
+ * was set, once enough frames have been rendered.
+ */
+static bool	mlx_should_close(t_mlx *mlx)
 {
-	t_draw_queue	*entry;
-	t_mlx_list		*render_queue;
 	const t_mlx_ctx	*mlxctx = mlx->context;
 
-	render_queue = mlxctx->render_queue;
-	while (render_queue)
-	{
-		entry = render_queue->content;
-		if (entry->image && entry->instance && entry->image->enabled)
-			mlx_draw_instance(mlx, entry->image, entry->instance);
-		render_queue = render_queue->next;
-	}
+	if (mlxctx->frame_limit && mlxctx->frames >= mlxctx->frame_limit)
+		return (true);
+	if (mlxctx->software)
+		return (mlxctx->closing);
+	return (glfwWindowShouldClose(mlx->window));
 }
 
 int32_t	mlx_get_time(void)
@@ -95,19 +84,24 @@ void	mlx_loop(t_mlx *mlx)
 {
 	double		start;
 	double		oldstart;
+	t_mlx_ctx	*mlxctx;
 
-	oldstart = 0;
-	while (!glfwWindowShouldClose(mlx->window))
+	mlxctx = mlx->context;
+	oldstart = mlxctx->epoch;
+	while (!mlx_should_close(mlx))
 	{
-		start = glfwGetTime();
+		start = mlx_stats_begin(mlxctx);
 		mlx->delta_time = start - oldstart;
 		oldstart = start;
-		glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		glfwGetWindowSize(mlx->window, &(mlx->width), &(mlx->height));
 		mlx_exec_loop_hooks(mlx);
-		mlx_render_images(mlx);
-		glfwSwapBuffers(mlx->window);
-		glfwPollEvents();
+		mlx_loader_update(mlx);
+		mlx_queue_compact(mlxctx);
+		mlx_stats_mark(mlxctx, MLX_PHASE_HOOKS);
+		if (mlxctx->software)
+			mlx_software_render(mlx);
+		else
+			mlx_render_frame(mlx);
+		mlx_stats_end(mlxctx);
+		mlxctx->frames++;
 	}
 }
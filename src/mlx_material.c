@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_material.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/01 10:12:38 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 13:02:44 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Switches to the program of another material. Its uniforms may be stale,
+ * so the remembered quad and indexed values are uploaded to it.
+ */
+static void	mlx_use_material(t_mlx_ctx *mlxctx, int32_t material)
+{
+	const t_mlx_material	*m = &mlxctx->materials[material];
+	const float				*q = mlxctx->quad;
+
+	glUseProgram(m->program);
+	glUniform2f(m->size_loc, q[0], q[1]);
+	glUniform4f(m->uv_loc, q[2], q[3], q[4], q[5]);
+	glUniform1i(m->indexed_loc, mlxctx->indexed);
+	glUniform1i(m->blend_loc, mlxctx->blend);
+	mlxctx->size_loc = m->size_loc;
+	mlxctx->uv_loc = m->uv_loc;
+	mlxctx->indexed_loc = m->indexed_loc;
+	mlxctx->material = material;
+}
+
+/**
+ * Makes the given material and blend mode the ones in use, nothing is
+ * changed if they already are. Multiply only affects the colors, the
+ * alpha of the frame is kept.
+ * 
+ * @param mlxctx The MLX context.
+ * @param material The index of the material.
+ * @param blend The blend mode.
+ */
+void	mlx_set_state(t_mlx_ctx *mlxctx, int32_t material, t_mlx_blend blend)
+{
+	const GLenum	src[5] = {GL_SRC_ALPHA, GL_ONE, GL_SRC_ALPHA, \
+	GL_DST_COLOR, GL_ONE};
+	const GLenum	dst[5] = {GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, \
+	GL_ONE, GL_ZERO, GL_ZERO};
+	const GLenum	asrc[5] = {GL_SRC_ALPHA, GL_ONE, GL_SRC_ALPHA, GL_ZERO, \
+	GL_ONE};
+	const GLenum	adst[5] = {GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, \
+	GL_ONE, GL_ONE, GL_ZERO};
+
+	if (mlxctx->blend != blend)
+	{
+		glBlendFuncSeparate(src[blend], dst[blend], asrc[blend], adst[blend]);
+		if (mlxctx->material == material)
+			glUniform1i(mlxctx->materials[material].blend_loc, blend);
+		mlxctx->blend = blend;
+	}
+	if (mlxctx->material != material)
+		mlx_use_material(mlxctx, material);
+}
+
+/**
+ * Builds the program of a material from a fragment shader, the material
+ * keeps a copy of the source to tell it apart from others.
+ * 
+ * @param mlxctx The MLX context.
+ * @param frag The source of the fragment shader.
+ * @param material The material to fill in.
+ * @return If the material could be built.
+ */
+static bool	mlx_material_build(t_mlx_ctx *mlxctx, const char *frag, \
+t_mlx_material *material)
+{
+	material->program = 0;
+	material->key = mlx_fnv_hash(frag, strlen(frag));
+	material->source = strdup(frag);
+	if (!material->source)
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	if (mlx_build_program(mlxctx, (const char *[2]){g_default_vert, frag}, \
+		(const char *[2]){NULL, NULL}, &material->program))
+	{
+		mlx_material_uniforms(material);
+		return (true);
+	}
+	glDeleteProgram(material->program);
+	free(material->source);
+	return (mlx_log(MLX_ERROR, MLX_SHADER_FAILURE));
+}
+
+/**
+ * Finds the material with the given fragment shader or builds it, the
+ * projection is uploaded once it is added.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param frag The source of the fragment shader.
+ * @return The index of the material, -1 on failure.
+ */
+static int32_t	mlx_material_get(t_mlx *mlx, const char *frag)
+{
+	int32_t			found;
+	t_mlx_ctx		*mlxctx;
+	t_mlx_material	material;
+
+	mlxctx = mlx->context;
+	found = mlx_material_find(mlxctx, frag);
+	if (found >= 0)
+		return (found);
+	if (!mlx_grow((void **)&mlxctx->materials, &mlxctx->material_cap, \
+		mlxctx->material_count + 1, sizeof(t_mlx_material)) || \
+		!mlx_material_build(mlxctx, frag, &material))
+		return (-1);
+	mlxctx->materials[mlxctx->material_count++] = material;
+	mlx_update_matrix(mlx, mlx->width, mlx->height);
+	return (mlxctx->material_count - 1);
+}
+
+//= Exposed =//
+
+bool	mlx_image_set_shader(t_mlx *mlx, t_mlx_image *img, const char *frag)
+{
+	int32_t			material;
+	t_mlx_image_ctx	*imgctx;
+
+	if (!mlx || !img)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	imgctx = img->context;
+	if (imgctx->software)
+		return (mlx_log(MLX_WARNING, MLX_NOT_SOFTWARE));
+	material = 0;
+	if (frag)
+		material = mlx_material_get(mlx, frag);
+	if (material < 0)
+		return (false);
+	imgctx->material = material;
+	return (true);
+}
@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_material_utils.c                               :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/04 13:02:44 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 13:02:44 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_material_utils.c                               :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/01 10:12:38 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Looks for a material built from the same source. The hash only rules
+ * out most materials, the source is compared for those that remain.
+ * 
+ * @param mlxctx The MLX context.
+ * @param frag The source of the fragment shader.
+ * @return The index of the material, -1 if there is none.
+ */
+int32_t	mlx_material_find(const t_mlx_ctx *mlxctx, const char *frag)
+{
+	int32_t			i;
+	const size_t	len = strlen(frag);
+	const uint64_t	key = mlx_fnv_hash(frag, len);
+
+	i = 0;
+	while (i < mlxctx->material_count)
+	{
+		if (mlxctx->materials[i].key == key && \
+			strcmp(mlxctx->materials[i].source, frag) == 0)
+			return (i);
+		i++;
+	}
+	return (-1);
+}
+
+// Releases the sources of the materials along with the materials.
+void	mlx_free_materials(t_mlx_ctx *mlxctx)
+{
+	int32_t	i;
+
+	i = 0;
+	while (i < mlxctx->material_count)
+		free(mlxctx->materials[i++].source);
+	free(mlxctx->materials);
+}
@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_postprocess.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/28 16:41:27 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 12:20:05 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Creates both color targets and the depth buffer the frame is drawn
+ * with. They start out at a single pixel, the first frame resizes them.
+ */
+static bool	mlx_post_targets(t_mlx_ctx *mlxctx, t_mlx_post *post)
+{
+	int32_t	i;
+	bool	complete;
+
+	i = 0;
+	complete = true;
+	glGenFramebuffers(2, post->fbo);
+	glGenRenderbuffers(1, &post->depth);
+	glBindRenderbuffer(GL_RENDERBUFFER, post->depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, 1, 1);
+	while (i < 2)
+	{
+		post->texture[i] = mlx_create_texture(1, 1);
+		glBindFramebuffer(GL_FRAMEBUFFER, post->fbo[i]);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, \
+		GL_TEXTURE_2D, post->texture[i], 0);
+		if (i++ == 0)
+			glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, \
+			GL_RENDERBUFFER, post->depth);
+		complete &= glCheckFramebufferStatus(GL_FRAMEBUFFER) == \
+		GL_FRAMEBUFFER_COMPLETE;
+	}
+	glBindFramebuffer(GL_FRAMEBUFFER, mlxctx->fbo);
+	post->size[0] = 1;
+	post->size[1] = 1;
+	return (complete);
+}
+
+// Sets up the targets and a vertex array of the unit quad, once.
+static bool	mlx_post_init(t_mlx_ctx *mlxctx)
+{
+	t_mlx_post	*post;
+
+	post = &mlxctx->post;
+	if (post->vao)
+		return (true);
+	if (!mlx_post_targets(mlxctx, post))
+		return (mlx_log(MLX_ERROR, MLX_FRAMEBUFFER_FAILURE));
+	glGenVertexArrays(1, &post->vao);
+	glBindVertexArray(post->vao);
+	glBindBuffer(GL_ARRAY_BUFFER, mlxctx->vbo);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(t_vert), NULL);
+	glEnableVertexAttribArray(0);
+	return (true);
+}
+
+// Builds the program of a pass and resolves its builtin uniforms.
+static t_mlx_effect	*mlx_effect_build(t_mlx_ctx *mlxctx, const char *frag)
+{
+	t_mlx_effect		*effect;
+	t_mlx_effect_ctx	*effectctx;
+
+	effect = calloc(1, sizeof(t_mlx_effect));
+	effectctx = calloc(1, sizeof(t_mlx_effect_ctx));
+	if (!effect || !effectctx)
+	{
+		mlx_freen(2, effect, effectctx);
+		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	if (!mlx_build_program(mlxctx, (const char *[2]){g_post_vert, frag}, \
+		(const char *[2]){NULL, NULL}, &effectctx->program))
+	{
+		glDeleteProgram(effectctx->program);
+		mlx_freen(2, effect, effectctx);
+		return ((void *)mlx_log(MLX_ERROR, MLX_SHADER_FAILURE));
+	}
+	glUseProgram(effectctx->program);
+	glUniform1i(glGetUniformLocation(effectctx->program, "Frame"), 0);
+	effectctx->resolution_loc = glGetUniformLocation(effectctx->program, \
+	"Resolution");
+	effectctx->time_loc = glGetUniformLocation(effectctx->program, "Time");
+	effect->context = effectctx;
+	effect->enabled = true;
+	return (effect);
+}
+
+//= Exposed =//
+
+t_mlx_effect	*mlx_add_postprocess(t_mlx *mlx, const char *frag)
+{
+	t_mlx_ctx		*mlxctx;
+	t_mlx_effect	*effect;
+
+	if (!mlx || !frag)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	mlxctx = mlx->context;
+	if (mlxctx->software)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NOT_SOFTWARE));
+	if (!mlx_post_init(mlxctx) || !mlx_grow((void **)&mlxctx->post.effects, \
+		&mlxctx->post.cap, mlxctx->post.count + 1, sizeof(t_mlx_effect *)))
+		return (NULL);
+	effect = mlx_effect_build(mlxctx, frag);
+	if (effect)
+		mlxctx->post.effects[mlxctx->post.count++] = effect;
+	return (effect);
+}
+
+bool	mlx_set_uniform(t_mlx_effect *effect, const char *name, \
+const float *value, int32_t count)
+{
+	GLint				loc;
+	t_mlx_effect_ctx	*effectctx;
+
+	if (!effect || !name || !value)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (count < 1 || count > 4)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	effectctx = effect->context;
+	loc = mlx_uniform_location(effectctx, name);
+	glUseProgram(effectctx->program);
+	if (count == 1)
+		glUniform1fv(loc, 1, value);
+	else if (count == 2)
+		glUniform2fv(loc, 1, value);
+	else if (count == 3)
+		glUniform3fv(loc, 1, value);
+	else
+		glUniform4fv(loc, 1, value);
+	return (true);
+}
@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_postprocess_render.c                           :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/28 16:41:27 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/28 16:41:27 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Reallocates the targets for a new viewport size, attachments stay valid.
+static void	mlx_post_resize(t_mlx_post *post, int32_t width, int32_t height)
+{
+	glBindTexture(GL_TEXTURE_2D, post->texture[0]);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, \
+	GL_UNSIGNED_BYTE, NULL);
+	glBindTexture(GL_TEXTURE_2D, post->texture[1]);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, \
+	GL_UNSIGNED_BYTE, NULL);
+	glBindRenderbuffer(GL_RENDERBUFFER, post->depth);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, \
+	width, height);
+	post->size[0] = width;
+	post->size[1] = height;
+}
+
+// Runs a single pass over the src target, into the other one or the window.
+static void	mlx_post_pass(t_mlx_ctx *mlxctx, const t_mlx_effect *effect, \
+int32_t src, bool last)
+{
+	const t_mlx_effect_ctx	*effectctx = effect->context;
+
+	if (last)
+		glBindFramebuffer(GL_FRAMEBUFFER, mlxctx->fbo);
+	else
+		glBindFramebuffer(GL_FRAMEBUFFER, mlxctx->post.fbo[!src]);
+	glUseProgram(effectctx->program);
+	glUniform2f(effectctx->resolution_loc, mlxctx->post.size[0], \
+	mlxctx->post.size[1]);
+	glUniform1f(effectctx->time_loc, glfwGetTime());
+	glBindTexture(GL_TEXTURE_2D, mlxctx->post.texture[src]);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	mlxctx->stats.counts.draw_calls++;
+}
+
+/**
+ * Redirects the drawing of the frame into the first target, as long as
+ * any pass is enabled. The targets follow the size of the viewport, so
+ * the passes work on the same pixels that end up on the window.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_post_begin(t_mlx *mlx)
+{
+	int32_t		i;
+	GLint		viewport[4];
+	t_mlx_post	*post;
+
+	post = &((t_mlx_ctx *)mlx->context)->post;
+	i = post->count;
+	while (i > 0 && !post->effects[i - 1]->enabled)
+		i--;
+	post->last = i - 1;
+	if (post->last < 0)
+		return ;
+	glGetIntegerv(GL_VIEWPORT, viewport);
+	if (viewport[2] != post->size[0] || viewport[3] != post->size[1])
+		mlx_post_resize(post, viewport[2], viewport[3]);
+	glBindFramebuffer(GL_FRAMEBUFFER, post->fbo[0]);
+}
+
+/**
+ * Runs the enabled passes in order, each one reads the target the previous
+ * one wrote. The last pass writes to the window, or the framebuffer of a
+ * headless instance, without blending.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_post_render(t_mlx *mlx)
+{
+	int32_t		i;
+	int32_t		src;
+	t_mlx_ctx	*mlxctx;
+
+	i = -1;
+	src = 0;
+	mlxctx = mlx->context;
+	if (mlxctx->post.last < 0)
+		return ;
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_BLEND);
+	glBindVertexArray(mlxctx->post.vao);
+	glActiveTexture(GL_TEXTURE0);
+	while (++i <= mlxctx->post.last)
+	{
+		if (mlxctx->post.effects[i]->enabled)
+		{
+			mlx_post_pass(mlxctx, mlxctx->post.effects[i], src, \
+			i == mlxctx->post.last);
+			src = !src;
+		}
+	}
+	glEnable(GL_BLEND);
+	glEnable(GL_DEPTH_TEST);
+}
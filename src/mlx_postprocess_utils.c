@@ -0,0 +1,84 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_postprocess_utils.c                            :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/28 16:41:27 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 12:20:05 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Releases the memory of every pass, their programs went with OpenGL.
+void	mlx_free_postprocess(t_mlx_ctx *mlxctx)
+{
+	int32_t	i;
+
+	i = 0;
+	while (i < mlxctx->post.count)
+	{
+		free(mlxctx->post.effects[i]->context);
+		free(mlxctx->post.effects[i++]);
+	}
+	free(mlxctx->post.effects);
+}
+
+/**
+ * Finds the location of a uniform of a pass. The location of a name is
+ * remembered the first time, so setting it every frame doesn't query
+ * OpenGL again. Names that are too long, or come after the first
+ * MLX_UNIFORMS, are looked up every time.
+ * 
+ * @param effectctx The context of the pass.
+ * @param name The name of the uniform.
+ * @return The location, -1 if the program lacks the uniform.
+ */
+GLint	mlx_uniform_location(t_mlx_effect_ctx *effectctx, const char *name)
+{
+	int32_t			i;
+	GLint			loc;
+	const size_t	len = strlen(name);
+	t_mlx_uniform	*uniform;
+
+	i = 0;
+	while (i < effectctx->uniform_count)
+	{
+		uniform = &effectctx->uniforms[i++];
+		if (strcmp(uniform->name, name) == 0)
+			return (uniform->loc);
+	}
+	loc = glGetUniformLocation(effectctx->program, name);
+	if (i == MLX_UNIFORMS || len >= MLX_UNIFORM_NAME)
+		return (loc);
+	uniform = &effectctx->uniforms[effectctx->uniform_count++];
+	memcpy(uniform->name, name, len + 1);
+	uniform->loc = loc;
+	return (loc);
+}
+
+//= Exposed =//
+
+void	mlx_delete_postprocess(t_mlx *mlx, t_mlx_effect *effect)
+{
+	int32_t		i;
+	t_mlx_post	*post;
+
+	if (!mlx || !effect)
+	{
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
+	}
+	i = 0;
+	post = &((t_mlx_ctx *)mlx->context)->post;
+	while (i < post->count && post->effects[i] != effect)
+		i++;
+	if (i == post->count)
+		return ;
+	memmove(&post->effects[i], &post->effects[i + 1], \
+	(--post->count - i) * sizeof(t_mlx_effect *));
+	glDeleteProgram(((t_mlx_effect_ctx *)effect->context)->program);
+	mlx_freen(2, effect->context, effect);
+}
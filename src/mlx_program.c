@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_program.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/28 13:24:52 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/05 09:14:22 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Names the file of a program in the cache after the hash of its sources
+ * and the driver, a binary is only valid for the driver it came from.
+ * 
+ * @param cache The program cache.
+ * @param src The vertex & fragment shader source.
+ * @param path Set to the file of the program, of MLX_CACHE_FILE bytes.
+ * @return If the name fit, the cache is skipped otherwise.
+ */
+static bool	mlx_program_path(const t_mlx_cache *cache, \
+const char *const src[2], char *path)
+{
+	int32_t			i;
+	int32_t			len;
+	uint64_t		hash;
+	const char		*str;
+	const GLenum	names[3] = {GL_VENDOR, GL_RENDERER, GL_VERSION};
+
+	i = 0;
+	hash = mlx_fnv_hash("MLX42", 5);
+	while (i < 3)
+	{
+		str = (const char *)glGetString(names[i++]);
+		if (str)
+			hash = mlx_fnv_append(hash, str, strlen(str) + 1);
+	}
+	hash = mlx_fnv_append(hash, src[0], strlen(src[0]) + 1);
+	hash = mlx_fnv_append(hash, src[1], strlen(src[1]) + 1);
+	len = snprintf(path, MLX_CACHE_FILE, "%s/%016" PRIx64 ".bin", \
+	cache->dir, hash);
+	return (len > 0 && len < MLX_CACHE_FILE);
+}
+
+// Compiles the vertex & fragment shader and links them into a program.
+static bool	mlx_program_compile(const t_mlx_cache *cache, \
+const char *const src[2], const char *const path[2], GLuint *program)
+{
+	uint32_t	s[3];
+
+	s[2] = 0;
+	if (!mlx_compile_shader(src[0], path[0], GL_VERTEX_SHADER, &s[0]))
+		return (false);
+	if (!mlx_compile_shader(src[1], path[1], GL_FRAGMENT_SHADER, &s[1]))
+	{
+		glDeleteShader(s[0]);
+		return (false);
+	}
+	return (mlx_link_program(s, program, cache));
+}
+
+/**
+ * Builds a shader program, loading it from the program cache if it has
+ * been built before. Otherwise it is compiled, linked and then cached.
+ * Shaders read from an override path are never cached.
+ * 
+ * @param mlxctx The MLX context.
+ * @param src The built in vertex & fragment shader source.
+ * @param path The paths to read the shaders from instead, or NULL.
+ * @param program The resulting program.
+ * @return Wether the program could be built.
+ */
+bool	mlx_build_program(t_mlx_ctx *mlxctx, const char *const src[2], \
+const char *const path[2], GLuint *program)
+{
+	bool			built;
+	bool			cached;
+	char			file[MLX_CACHE_FILE];
+	const double	start = mlx_stats_time(mlxctx);
+
+	cached = mlxctx->cache.get && !path[0] && !path[1] && \
+		mlx_program_path(&mlxctx->cache, src, file);
+	built = cached && mlx_cache_load(&mlxctx->cache, file, program);
+	mlxctx->stats.cache_hits += built;
+	if (!built)
+	{
+		built = mlx_program_compile(&mlxctx->cache, src, path, program);
+		if (built && cached)
+			mlx_cache_store(&mlxctx->cache, file, *program);
+	}
+	mlxctx->stats.shaders += mlx_stats_time(mlxctx) - start;
+	return (built);
+}
@@ -6,14 +6,14 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 03:30:13 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/09 10:44:33 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/04 13:41:09 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "MLX42/MLX42_Int.h"
 
 // Simply for convenience and avoiding code duplication.
-static void	mlx_draw_pixel(uint8_t *pixel, uint32_t color)
+void	mlx_draw_pixel(uint8_t *pixel, uint32_t color)
 {
 	*(pixel + 0) = (uint8_t)((color >> 24) & 0xFF);
 	*(pixel + 1) = (uint8_t)((color >> 16) & 0xFF);
@@ -21,24 +21,56 @@ static void	mlx_draw_pixel(uint8_t *pixel, uint32_t color)
 	*(pixel + 3) = (uint8_t)((color >> 0) & 0xFF);
 }
 
-void	mlx_xpm_putpixel(t_xpm *xpm, int32_t x, int32_t y, uint32_t color)
-{
-	uint8_t	*pixelstart;
-
-	pixelstart = &xpm->texture.pixels[(y * xpm->texture.width + x) * \
-	sizeof(int32_t)];
-	mlx_draw_pixel(pixelstart, color);
-}
-
 void	mlx_putpixel(t_mlx_image *image, int32_t x, int32_t y, uint32_t color)
 {
-	uint8_t	*pixelstart;
+	uint8_t			*pixelstart;
+	t_mlx_image_ctx	*imgctx;
 
 	if (!image)
 	{
 		mlx_log(MLX_WARNING, MLX_NULL_ARG);
 		return ;
 	}
-	pixelstart = &image->pixels[(y * image->width + x) * sizeof(int32_t)];
-	mlx_draw_pixel(pixelstart, color);
+	imgctx = image->context;
+	pixelstart = &image->pixels[(y * image->width + x) * imgctx->bpp];
+	if (imgctx->palette)
+		*pixelstart = color;
+	else
+		mlx_draw_pixel(pixelstart, color);
+	mlx_dirty_add(image, (t_mlx_rect){x, y, 1, 1});
+}
+
+/**
+ * Copies an RGBA texture onto the image row by row and marks the
+ * covered area as dirty once, instead of going through every pixel.
+ * The texture has to lie within the image entirely.
+ * 
+ * @param image The image to draw onto.
+ * @param texture The texture to draw, must be RGBA.
+ * @param x The X position offset for the texture.
+ * @param y The Y position offset for the texture.
+ * @return If the function was able to draw onto the image.
+ */
+bool	mlx_blit_texture(t_mlx_image *image, t_mlx_texture *texture, \
+int32_t x, int32_t y)
+{
+	int32_t	i;
+	size_t	rowsize;
+
+	if (!texture || !image)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (((t_mlx_image_ctx *)image->context)->palette)
+		return (mlx_log(MLX_ERROR, MLX_INDEXED));
+	if (texture->bytes_per_pixel != sizeof(int32_t))
+		return (mlx_log(MLX_ERROR, MLX_INVALID_ARG));
+	if (x < 0 || y < 0 || (int64_t)x + texture->width > image->width || \
+		(int64_t)y + texture->height > image->height)
+		return (mlx_log(MLX_ERROR, "Texture does not fit onto the image!"));
+	i = -1;
+	rowsize = texture->width * texture->bytes_per_pixel;
+	while (++i < texture->height)
+		memcpy(&image->pixels[((y + i) * image->width + x) * \
+		sizeof(int32_t)], &texture->pixels[i * rowsize], rowsize);
+	mlx_dirty_add(image, (t_mlx_rect){x, y, texture->width, texture->height});
+	return (true);
 }
@@ -0,0 +1,154 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_render.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/19 14:21:05 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Sets the ImageSize and UVRect uniforms, values that are already
+ * set are not uploaded again.
+ * 
+ * @param mlxctx The MLX context.
+ * @param quad The width & height followed by the UV offset & scale.
+ */
+void	mlx_set_quad(t_mlx_ctx *mlxctx, const float quad[6])
+{
+	if (mlxctx->quad[0] != quad[0] || mlxctx->quad[1] != quad[1])
+		glUniform2f(mlxctx->size_loc, quad[0], quad[1]);
+	if (memcmp(&mlxctx->quad[2], &quad[2], 4 * sizeof(float)))
+		glUniform4f(mlxctx->uv_loc, quad[2], quad[3], quad[4], quad[5]);
+	memcpy(mlxctx->quad, quad, sizeof(mlxctx->quad));
+}
+
+/**
+ * Batched sprites carry their full location and atlas coordinates, the
+ * constant transform attributes make the vertex shader pass them through.
+ */
+static void	mlx_exec_cmd(t_mlx *mlx, t_mlx_cmd *cmd)
+{
+	t_mlx_ctx	*mlxctx;
+	const float	quad[6] = {1.f, 1.f, 0.f, 0.f, 1.f, 1.f};
+
+	if (cmd->image)
+	{
+		mlx_draw_instances(mlx, cmd->image, cmd->start, cmd->count);
+		return ;
+	}
+	mlxctx = mlx->context;
+	mlx_set_state(mlxctx, cmd->material, cmd->blend);
+	mlx_set_quad(mlxctx, quad);
+	mlx_palette_bind(mlxctx, NULL);
+	glVertexAttrib3f(3, 1.f, 1.f, 0.f);
+	glVertexAttrib4f(4, 0.f, 0.f, 1.f, 1.f);
+	glBindVertexArray(mlxctx->batch.vao);
+	glBindTexture(GL_TEXTURE_2D, cmd->texture);
+	glDrawArrays(GL_TRIANGLES, cmd->start, cmd->count);
+	mlxctx->stats.counts.draw_calls++;
+	mlxctx->stats.counts.instances += cmd->count / 6;
+}
+
+/**
+ * Uploads the sprite vertices of this frame at once and draws everything,
+ * the default material and blend mode are restored for the text after.
+ */
+static void	mlx_exec_batch(t_mlx *mlx)
+{
+	int32_t		i;
+	t_mlx_batch	*batch;
+
+	i = 0;
+	batch = &((t_mlx_ctx *)mlx->context)->batch;
+	if (batch->vert_count > 0)
+	{
+		glBindBuffer(GL_ARRAY_BUFFER, batch->vbo);
+		glBufferData(GL_ARRAY_BUFFER, batch->vert_count * sizeof(t_vert), \
+		batch->verts, GL_STREAM_DRAW);
+	}
+	glActiveTexture(GL_TEXTURE0);
+	while (i < batch->cmd_count)
+		mlx_exec_cmd(mlx, &batch->cmds[i++]);
+	mlx_set_state(mlx->context, 0, MLX_BLEND_ALPHA);
+	batch->vert_count = 0;
+	batch->cmd_count = 0;
+}
+
+/**
+ * Walks the render queue and merges consecutive entries of the same
+ * image into runs, which are then turned into draw commands.
+ * 
+ * A run is split as soon as the queue switches to another image or the
+ * instances are no longer in order, so the drawing order is maintained.
+ * The program may have been switched since the last frame, so the default
+ * material is bound again.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+static void	mlx_render_images(t_mlx *mlx)
+{
+	int32_t				i;
+	t_mlx_run			run;
+	const t_mlx_ctx		*mlxctx = mlx->context;
+	const t_draw_queue	*entry;
+
+	i = -1;
+	((t_mlx_ctx *)mlx->context)->material = -1;
+	mlx_set_state(mlx->context, 0, MLX_BLEND_ALPHA);
+	run = (t_mlx_run){NULL, 0, 0};
+	while (++i < mlxctx->queue_count)
+	{
+		entry = &mlxctx->render_queue[i];
+		if (entry->image->enabled && \
+			entry->image->instances[entry->instance].enabled)
+		{
+			if (entry->image != run.image || \
+				entry->instance != run.start + run.count)
+				mlx_batch_run(mlx, &run);
+			if (run.count == 0)
+				run = (t_mlx_run){entry->image, entry->instance, 0};
+			run.count++;
+		}
+	}
+	mlx_batch_run(mlx, &run);
+	mlx_exec_batch(mlx);
+}
+
+/**
+ * Clears the frame, draws the tilemaps, all images and then the text, runs
+ * the post-processing passes and presents the result, either on the window
+ * or, for headless instances, in the framebuffer object. Every step is
+ * timed, the GPU time of the drawing as well.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_render_frame(t_mlx *mlx)
+{
+	t_mlx_ctx	*mlxctx;
+
+	mlxctx = mlx->context;
+	mlx_stats_gpu_begin(mlxctx);
+	mlx_post_begin(mlx);
+	glClearColor(0.2f, 0.2f, 0.2f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	mlx_upload_images(mlx);
+	mlx_tilemap_render(mlx);
+	mlx_render_images(mlx);
+	mlx_text_render(mlx);
+	mlx_post_render(mlx);
+	mlx_stats_gpu_end(mlxctx);
+	mlx_stats_mark(mlxctx, MLX_PHASE_RENDER);
+	if (mlxctx->headless)
+		glFlush();
+	else
+		glfwSwapBuffers(mlx->window);
+	mlx_stats_mark(mlxctx, MLX_PHASE_SWAP);
+	glfwPollEvents();
+	mlx_stats_mark(mlxctx, MLX_PHASE_POLL);
+}
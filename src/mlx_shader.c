@@ -6,39 +6,62 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/01/01 13:46:01 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/02 12:28:29 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/05 09:40:03 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "MLX42/MLX42_Int.h"
 
 /**
- * Glues together all shaders to the shader program.
+ * Resolves the uniform locations of a material once, so drawing needs no
+ * string lookups, and binds the samplers to their texture units.
  * 
- * @param mlx The MLX instance.
- * @param shaders The array of shaders
- * @return Wether initilization was successful.
+ * @param material The material, its program has to be linked.
  */
-bool	mlx_init_shaders(t_mlx *mlx, uint32_t *shaders)
+void	mlx_material_uniforms(t_mlx_material *material)
+{
+	const GLuint	program = material->program;
+
+	glUseProgram(program);
+	glUniform1i(glGetUniformLocation(program, "OutTexture"), 0);
+	glUniform1i(glGetUniformLocation(program, "Palette"), 1);
+	material->indexed_loc = glGetUniformLocation(program, "Indexed");
+	material->proj_loc = glGetUniformLocation(program, "ProjMatrix");
+	material->size_loc = glGetUniformLocation(program, "ImageSize");
+	material->uv_loc = glGetUniformLocation(program, "UVRect");
+	material->blend_loc = glGetUniformLocation(program, "Blend");
+}
+
+/**
+ * Glues together the given shaders into a program, the shaders are
+ * deleted afterwards. With the program cache enabled the driver is told
+ * up front that the binary will be retrieved, some only keep it then.
+ * 
+ * @param shaders The shaders, terminated by 0.
+ * @param program The resulting program.
+ * @param cache The program cache.
+ * @return Wether linking was successful.
+ */
+bool	mlx_link_program(const uint32_t *shaders, GLuint *program, \
+const t_mlx_cache *cache)
 {
 	uint32_t	i;
 	int			success;
 	char		infolog[512];
-	t_mlx_ctx	*context;
 
 	i = 0;
-	context = mlx->context;
-	context->shaderprogram = glCreateProgram();
-	if (!context->shaderprogram)
+	*program = glCreateProgram();
+	if (!*program)
 		return (false);
 	while (shaders[i])
-		glAttachShader(context->shaderprogram, shaders[i++]);
-	glLinkProgram(context->shaderprogram);
-	glGetProgramiv(context->shaderprogram, GL_LINK_STATUS, &success);
+		glAttachShader(*program, shaders[i++]);
+	if (cache->hint)
+		cache->hint(*program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+	glLinkProgram(*program);
+	glGetProgramiv(*program, GL_LINK_STATUS, &success);
 	if (!success)
 	{
-		glGetProgramInfoLog(context->shaderprogram, sizeof(infolog), \
-		NULL, infolog);
+		glGetProgramInfoLog(*program, sizeof(infolog), NULL, infolog);
 		fprintf(stderr, "%s", infolog);
 		return (false);
 	}
@@ -49,35 +72,109 @@ bool	mlx_init_shaders(t_mlx *mlx, uint32_t *shaders)
 }
 
 /**
- * Opens the shader file and compiles it.
+ * Builds the default shader program, from the program cache if possible.
+ * It becomes the first material and the one in use.
  * 
- * @param Path File path to the shader.
+ * @param mlx The MLX instance.
+ * @return Wether initilization was successful.
+ */
+bool	mlx_init_shaders(t_mlx *mlx)
+{
+	t_mlx_ctx	*context;
+
+	context = mlx->context;
+	mlx_cache_init(context);
+	if (!mlx_grow((void **)&context->materials, &context->material_cap, 1, \
+		sizeof(t_mlx_material)))
+		return (false);
+	if (!mlx_build_program(context, (const char *[2]){g_default_vert, \
+		g_default_frag}, (const char *[2]){VERTEX_PATH, FRAGMENT_PATH}, \
+		&context->shaderprogram))
+		return (mlx_log(MLX_ERROR, MLX_SHADER_FAILURE));
+	context->materials[0].program = context->shaderprogram;
+	context->materials[0].key = mlx_fnv_hash(g_default_frag, \
+	strlen(g_default_frag));
+	context->materials[0].source = strdup(g_default_frag);
+	if (!context->materials[0].source)
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	context->material_count = 1;
+	mlx_material_uniforms(&context->materials[0]);
+	context->material = -1;
+	mlx_set_state(context, 0, MLX_BLEND_ALPHA);
+	return (true);
+}
+
+/**
+ * Recomputes the projection matrix for the given window size and uploads
+ * it to every material, this only has to happen when the window gets
+ * resized or a material is added.
+ * 
+ * Reference: https://bit.ly/3KuHOu1 (Matrix View Projection)
+ * 
+ * @param mlx The MLX instance.
+ * @param width The new width of the window.
+ * @param height The new height of the window.
+ */
+void	mlx_update_matrix(t_mlx *mlx, int32_t width, int32_t height)
+{
+	int32_t		i;
+	t_mlx_ctx	*mlxctx;
+	const float	matrix[16] = {
+		2.f / width, 0, 0, 0,
+		0, 2.f / -height, 0, 0,
+		0, 0, -2.f / (1000.f - -1000.f), 0,
+		-1, 1,
+		-((1000.f + -1000.f) / (1000.f - -1000.f)), 1
+	};
+
+	i = 0;
+	mlxctx = mlx->context;
+	mlx->width = width;
+	mlx->height = height;
+	while (i < mlxctx->material_count)
+	{
+		glUseProgram(mlxctx->materials[i].program);
+		glUniformMatrix4fv(mlxctx->materials[i++].proj_loc, 1, GL_FALSE, \
+		matrix);
+	}
+	mlxctx->material = -1;
+}
+
+/**
+ * Compiles a shader from the source that is built into the library, or
+ * from a file if an override path was defined when building it.
+ * 
+ * @param Source The built in source of the shader.
+ * @param Path File path to read the source from instead, or NULL.
  * @param Type GL_VERTEX_SHADER or GL_FRAGMENT_SHADER or ...
  * @return Whether it managed to compile the shader or not.
  */
-bool	mlx_compile_shader(const char *Path, int32_t Type, uint32_t *out)
+bool	mlx_compile_shader(const char *Source, const char *Path, int32_t Type, \
+uint32_t *out)
 {
-	GLint		len;
 	int32_t		success;
 	char		infolog[512];
-	const char	*shader_source = mlx_readfile(Path);
+	char		*file;
 
-	if (!shader_source)
+	file = NULL;
+	if (Path)
+		file = mlx_readfile(Path);
+	if (Path && !file)
 		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE));
-	len = strlen(shader_source);
+	if (file)
+		Source = file;
 	*out = glCreateShader(Type);
-	if (!*out)
-		return (false);
-	glShaderSource(*out, 1, &shader_source, &len);
-	glCompileShader(*out);
-	glGetShaderiv(*out, GL_COMPILE_STATUS, &success);
-	if (!success)
+	success = *out;
+	if (success)
 	{
-		glGetShaderInfoLog(*out, sizeof(infolog), NULL, infolog);
-		fprintf(stderr, "%s", infolog);
-		free((void *)shader_source);
-		return (false);
+		glShaderSource(*out, 1, &Source, NULL);
+		glCompileShader(*out);
+		glGetShaderiv(*out, GL_COMPILE_STATUS, &success);
 	}
-	free((void *)shader_source);
-	return (true);
+	free(file);
+	if (success)
+		return (true);
+	glGetShaderInfoLog(*out, sizeof(infolog), NULL, infolog);
+	fprintf(stderr, "%s", infolog);
+	return (false);
 }
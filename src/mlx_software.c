@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_software.c                                     :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/24 11:08:30 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * The software backend composites the render queue with the painter's
+ * algorithm, back to front. Just like the depth test of the OpenGL backend
+ * a higher z is closer and on equal depth the earliest instance wins, so
+ * those are drawn last.
+ */
+static int	mlx_layer_cmp(const void *a, const void *b)
+{
+	const t_mlx_layer	*la = a;
+	const t_mlx_layer	*lb = b;
+
+	if (la->z != lb->z)
+		return ((la->z > lb->z) - (la->z < lb->z));
+	return ((la->order < lb->order) - (la->order > lb->order));
+}
+
+// Gathers every visible instance of the render queue, false on failure.
+static bool	mlx_collect_layers(t_mlx_ctx *mlxctx, int32_t *count)
+{
+	int32_t			i;
+	t_draw_queue	*entry;
+	t_mlx_instance	*inst;
+
+	i = -1;
+	if (!mlx_grow((void **)&mlxctx->layers, &mlxctx->layer_cap, \
+		mlxctx->queue_count, sizeof(t_mlx_layer)))
+		return (false);
+	while (++i < mlxctx->queue_count)
+	{
+		entry = &mlxctx->render_queue[i];
+		inst = &entry->image->instances[entry->instance];
+		if (entry->image->enabled && inst->enabled)
+		{
+			mlxctx->layers[*count] = (t_mlx_layer){entry->image, inst, \
+			inst->z, *count};
+			(*count)++;
+		}
+	}
+	return (true);
+}
+
+/**
+ * Blends the part of the instance that lies within the frame, row by row.
+ * Scaled or rotated instances are sampled pixel by pixel instead.
+ */
+static void	mlx_composite_layer(t_mlx *mlx, uint8_t *frame, t_mlx_layer *l)
+{
+	int32_t			y;
+	int32_t			src[4];
+	t_mlx_rect		r;
+	const int32_t	x0 = l->inst->x * (l->inst->x < 0);
+	const int32_t	y0 = l->inst->y * (l->inst->y < 0);
+
+	if (mlx_instance_transformed(l->inst))
+	{
+		mlx_composite_xform(mlx, frame, l);
+		return ;
+	}
+	mlx_instance_src(l->image, l->inst, src);
+	r = (t_mlx_rect){l->inst->x - x0, l->inst->y - y0, src[2] + x0, \
+	src[3] + y0};
+	if (r.x + r.w > mlx->width)
+		r.w = mlx->width - r.x;
+	if (r.y + r.h > mlx->height)
+		r.h = mlx->height - r.y;
+	y = -1;
+	while (++y < r.h)
+		mlx_blend_layer(l, &frame[((r.y + y) * mlx->width + r.x) * \
+		sizeof(int32_t)], (src[1] + y - y0) * l->image->width + src[0] - x0, \
+		r.w);
+}
+
+// Fills the frame with the same color the OpenGL backend clears to.
+static void	mlx_clear_frame(t_mlx *mlx, uint8_t *frame)
+{
+	int32_t			i;
+	const uint8_t	color[4] = {0x33, 0x33, 0x33, 0xFF};
+	const size_t	stride = mlx->width * sizeof(int32_t);
+
+	i = 0;
+	while (i < mlx->width)
+		memcpy(&frame[i++ * sizeof(int32_t)], color, sizeof(color));
+	i = 1;
+	while (i < mlx->height)
+		memcpy(&frame[i++ * stride], frame, stride);
+}
+
+/**
+ * Renders a frame of a software instance into its frame buffer.
+ * There is nothing to swap or poll, so all of it counts as rendering.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_software_render(t_mlx *mlx)
+{
+	int32_t		i;
+	int32_t		count;
+	t_mlx_ctx	*mlxctx;
+
+	i = 0;
+	count = 0;
+	mlxctx = mlx->context;
+	mlx_clear_frame(mlx, mlxctx->frame);
+	mlx_tilemap_composite(mlx, mlxctx->frame);
+	if (!mlx_collect_layers(mlxctx, &count))
+		return ;
+	if (count > 1)
+		qsort(mlxctx->layers, count, sizeof(t_mlx_layer), &mlx_layer_cmp);
+	while (i < count)
+		mlx_composite_layer(mlx, mlxctx->frame, &mlxctx->layers[i++]);
+	mlx_text_composite(mlx, mlxctx->frame);
+	mlxctx->stats.counts.instances += count;
+	mlx_stats_mark(mlxctx, MLX_PHASE_RENDER);
+}
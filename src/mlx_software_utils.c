@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_software_utils.c                               :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/24 11:52:04 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/28 13:24:52 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Gets the current time in seconds, software instances don't initialize
+ * GLFW and therefore can't use its timer.
+ */
+double	mlx_software_time(void)
+{
+	struct timespec	now;
+
+	timespec_get(&now, TIME_UTC);
+	return (now.tv_sec + now.tv_nsec / 1000000000.0);
+}
+
+//= Exposed =//
+
+t_mlx	*mlx_init_software(int32_t width, int32_t height)
+{
+	t_mlx			*mlx;
+	t_mlx_ctx		*mlxctx;
+	const double	start = mlx_software_time();
+
+	if (width <= 0 || height <= 0)
+		return ((void *)mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	mlx = calloc(1, sizeof(t_mlx));
+	mlxctx = calloc(1, sizeof(t_mlx_ctx));
+	if (mlxctx)
+		mlxctx->frame = malloc(width * height * sizeof(int32_t));
+	if (!mlx || !mlxctx || !mlxctx->frame)
+	{
+		if (mlxctx)
+			free(mlxctx->frame);
+		mlx_freen(2, mlx, mlxctx);
+		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	mlx->width = width;
+	mlx->height = height;
+	mlx->context = mlxctx;
+	mlxctx->software = true;
+	mlxctx->epoch = mlx_software_time();
+	mlxctx->stats.startup = mlxctx->epoch - start;
+	return (mlx);
+}
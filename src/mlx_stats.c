@@ -0,0 +1,88 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stats.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 10:04:19 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 14:12:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Adds a sample to the ring, replacing the oldest one once it is full.
+ * 
+ * @param ring The ring to add the sample to.
+ * @param ms The sample in milliseconds.
+ */
+void	mlx_ring_push(t_mlx_ring *ring, double ms)
+{
+	ring->samples[ring->index] = ms;
+	ring->index = (ring->index + 1) % MLX_STATS_FRAMES;
+	if (ring->count < MLX_STATS_FRAMES)
+		ring->count++;
+}
+
+// High resolution time in seconds, from the timer that fits the backend.
+double	mlx_stats_time(const t_mlx_ctx *mlxctx)
+{
+	if (mlxctx->software)
+		return (mlx_software_time());
+	return (glfwGetTime());
+}
+
+/**
+ * Adds the time since the previous mark to the given phase.
+ * 
+ * @param mlxctx The MLX context.
+ * @param phase The phase that just ended.
+ */
+void	mlx_stats_mark(t_mlx_ctx *mlxctx, t_mlx_phase phase)
+{
+	const double	now = mlx_stats_time(mlxctx);
+
+	mlxctx->stats.phase[phase] += now - mlxctx->stats.mark;
+	mlxctx->stats.mark = now;
+}
+
+/**
+ * Starts timing a new frame, resetting the times and counters.
+ * 
+ * @param mlxctx The MLX context.
+ * @return The time at which the frame started.
+ */
+double	mlx_stats_begin(t_mlx_ctx *mlxctx)
+{
+	t_mlx_stats		*stats;
+	const double	now = mlx_stats_time(mlxctx);
+
+	stats = &mlxctx->stats;
+	memset(stats->phase, 0, sizeof(stats->phase));
+	memset(&stats->counts, 0, sizeof(stats->counts));
+	stats->start = now;
+	stats->mark = now;
+	return (now);
+}
+
+// Pushes the times and uploads of the finished frame, except the GPU time.
+void	mlx_stats_end(t_mlx_ctx *mlxctx)
+{
+	int32_t		i;
+	t_mlx_stats	*stats;
+
+	i = 0;
+	stats = &mlxctx->stats;
+	stats->phase[MLX_PHASE_FRAME] = mlx_stats_time(mlxctx) - stats->start;
+	while (i < MLX_PHASE_COUNT)
+	{
+		if (i != MLX_PHASE_GPU)
+			mlx_ring_push(&stats->rings[i], stats->phase[i] * 1000.0);
+		i++;
+	}
+	stats->last = stats->counts;
+	stats->upload_total += stats->counts.upload_bytes;
+	stats->upload_frames++;
+}
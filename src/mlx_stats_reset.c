@@ -0,0 +1,47 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stats_reset.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/04 14:12:37 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 14:12:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stats_reset.c                                 :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 10:04:19 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/25 10:04:19 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+//= Exposed =//
+
+/**
+ * Timer queries still in flight belong to the frames before the reset,
+ * so they are dropped instead of read.
+ */
+void	mlx_reset_frame_stats(t_mlx *mlx)
+{
+	t_mlx_stats	*stats;
+
+	if (!mlx)
+	{
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
+	}
+	stats = &((t_mlx_ctx *)mlx->context)->stats;
+	memset(stats->rings, 0, sizeof(stats->rings));
+	memset(stats->issued, 0, sizeof(stats->issued));
+	stats->upload_total = 0;
+	stats->upload_frames = 0;
+}
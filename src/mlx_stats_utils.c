@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stats_utils.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/25 10:47:33 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 14:12:37 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+static int	mlx_float_cmp(const void *a, const void *b)
+{
+	const float	fa = *(const float *)a;
+	const float	fb = *(const float *)b;
+
+	return ((fa > fb) - (fa < fb));
+}
+
+// Sorts a copy of the samples to find the minimum, mean and 99th percentile.
+static void	mlx_ring_timing(const t_mlx_ring *ring, t_mlx_timing *out)
+{
+	int32_t	i;
+	float	sorted[MLX_STATS_FRAMES];
+
+	i = 0;
+	*out = (t_mlx_timing){0, 0, 0};
+	if (ring->count == 0)
+		return ;
+	memcpy(sorted, ring->samples, ring->count * sizeof(float));
+	qsort(sorted, ring->count, sizeof(float), &mlx_float_cmp);
+	while (i < ring->count)
+		out->mean += sorted[i++];
+	out->mean /= ring->count;
+	out->min = sorted[0];
+	out->p99 = sorted[(ring->count * 99 + 99) / 100 - 1];
+}
+
+/**
+ * Starts the timer query of this frame. The query is reused from a few
+ * frames ago, if its result is available by now it is collected first,
+ * otherwise that sample is dropped instead of waiting for the GPU.
+ * 
+ * @param mlxctx The MLX context.
+ */
+void	mlx_stats_gpu_begin(t_mlx_ctx *mlxctx)
+{
+	GLint		available;
+	GLuint64	elapsed;
+	t_mlx_stats	*stats;
+
+	stats = &mlxctx->stats;
+	if (!stats->queries[0])
+		glGenQueries(MLX_STATS_QUERIES, stats->queries);
+	if (stats->issued[stats->query])
+	{
+		glGetQueryObjectiv(stats->queries[stats->query], \
+		GL_QUERY_RESULT_AVAILABLE, &available);
+		if (available)
+		{
+			glGetQueryObjectui64v(stats->queries[stats->query], \
+			GL_QUERY_RESULT, &elapsed);
+			mlx_ring_push(&stats->rings[MLX_PHASE_GPU], elapsed / 1000000.0);
+		}
+	}
+	glBeginQuery(GL_TIME_ELAPSED, stats->queries[stats->query]);
+	stats->issued[stats->query] = true;
+}
+
+void	mlx_stats_gpu_end(t_mlx_ctx *mlxctx)
+{
+	glEndQuery(GL_TIME_ELAPSED);
+	mlxctx->stats.query = (mlxctx->stats.query + 1) % MLX_STATS_QUERIES;
+}
+
+//= Exposed =//
+
+bool	mlx_get_frame_stats(t_mlx *mlx, t_mlx_frame_stats *stats)
+{
+	const t_mlx_stats	*s;
+
+	if (!mlx || !stats)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	s = &((t_mlx_ctx *)mlx->context)->stats;
+	mlx_ring_timing(&s->rings[MLX_PHASE_POLL], &stats->poll);
+	mlx_ring_timing(&s->rings[MLX_PHASE_HOOKS], &stats->hooks);
+	mlx_ring_timing(&s->rings[MLX_PHASE_RENDER], &stats->render);
+	mlx_ring_timing(&s->rings[MLX_PHASE_SWAP], &stats->swap);
+	mlx_ring_timing(&s->rings[MLX_PHASE_GPU], &stats->gpu);
+	mlx_ring_timing(&s->rings[MLX_PHASE_FRAME], &stats->frame);
+	stats->frames = s->rings[MLX_PHASE_FRAME].count;
+	stats->draw_calls = s->last.draw_calls;
+	stats->instances = s->last.instances;
+	stats->upload_bytes = s->last.upload_bytes;
+	stats->upload_mean = 0;
+	if (s->upload_frames > 0)
+		stats->upload_mean = (double)s->upload_total / s->upload_frames;
+	stats->startup = s->startup * 1000.0;
+	stats->shaders = s->shaders * 1000.0;
+	stats->cache_hits = s->cache_hits;
+	return (true);
+}
@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stream.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/22 16:41:27 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 10:21:44 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Waits for the transfer that last used the buffer, counting any stalls.
+static void	mlx_stream_wait(t_mlx_stream *stream, int32_t i)
+{
+	if (!stream->fence[i])
+		return ;
+	if (glClientWaitSync(stream->fence[i], 0, 0) == GL_TIMEOUT_EXPIRED)
+	{
+		stream->waits++;
+		glClientWaitSync(stream->fence[i], GL_SYNC_FLUSH_COMMANDS_BIT, \
+		MLX_STREAM_TIMEOUT);
+	}
+	glDeleteSync(stream->fence[i]);
+	stream->fence[i] = NULL;
+}
+
+// Copies the dirty areas into the mapped buffer, which mirrors the pixels.
+static void	mlx_stream_copy(t_mlx_image *img, t_mlx_image_ctx *imgctx, \
+uint8_t *mapped)
+{
+	int32_t			y;
+	t_mlx_rect		*rect;
+	size_t			offset;
+	const size_t	bpp = imgctx->bpp;
+	const size_t	stride = img->width * bpp;
+
+	rect = imgctx->rects;
+	while (rect < imgctx->rects + imgctx->rect_count)
+	{
+		y = rect->y;
+		while (y < rect->y + rect->h)
+		{
+			offset = y++ * stride + rect->x * bpp;
+			memcpy(mapped + offset, img->pixels + offset, rect->w * bpp);
+		}
+		rect++;
+	}
+}
+
+// Fences the transfer that was just issued and moves on to the next buffer.
+static void	mlx_stream_fence(t_mlx_stream *stream)
+{
+	stream->fence[stream->index] = \
+	glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	stream->index = (stream->index + 1) % MLX_STREAM_BUFFERS;
+	stream->uploads++;
+}
+
+/**
+ * Uploads the dirty areas of a streaming image through the next buffer
+ * of its ring. The transfer itself happens asynchronously, so the pixels
+ * can be written again right away while the GPU is still reading.
+ * 
+ * If the buffer can't be mapped the pixels are uploaded directly instead.
+ * 
+ * @param img The streaming image, its texture must be bound.
+ */
+void	mlx_stream_upload(t_mlx_image *img)
+{
+	int32_t			i;
+	uint8_t			*src;
+	t_mlx_image_ctx	*imgctx;
+
+	i = 0;
+	imgctx = img->context;
+	mlx_stream_wait(imgctx->stream, imgctx->stream->index);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, \
+	imgctx->stream->pbo[imgctx->stream->index]);
+	src = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, img->width * \
+	img->height * imgctx->bpp, GL_MAP_WRITE_BIT | \
+	GL_MAP_UNSYNCHRONIZED_BIT);
+	if (src)
+		mlx_stream_copy(img, imgctx, src);
+	if (src && glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+		src = NULL;
+	else
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		src = img->pixels;
+	}
+	while (i < imgctx->rect_count)
+		mlx_upload_rect(img, &imgctx->rects[i++], src);
+	mlx_stream_fence(imgctx->stream);
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+}
+
+/**
+ * Waits for any pending transfers and releases the buffer ring.
+ * 
+ * @param imgctx The context of the streaming image.
+ */
+void	mlx_stream_free(t_mlx_image_ctx *imgctx)
+{
+	int32_t	i;
+
+	i = 0;
+	if (!imgctx->stream)
+		return ;
+	while (i < MLX_STREAM_BUFFERS)
+		mlx_stream_wait(imgctx->stream, i++);
+	glDeleteBuffers(MLX_STREAM_BUFFERS, imgctx->stream->pbo);
+	free(imgctx->stream);
+	imgctx->stream = NULL;
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_stream_utils.c                                 :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/22 17:03:50 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 10:21:44 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Creates the buffer ring, every buffer can hold the entire image.
+static bool	mlx_stream_create(t_mlx_image *img, t_mlx_image_ctx *imgctx)
+{
+	int32_t	i;
+
+	i = 0;
+	imgctx->stream = calloc(1, sizeof(t_mlx_stream));
+	if (!imgctx->stream)
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	glGenBuffers(MLX_STREAM_BUFFERS, imgctx->stream->pbo);
+	while (i < MLX_STREAM_BUFFERS)
+	{
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, imgctx->stream->pbo[i++]);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, img->width * img->height * \
+		imgctx->bpp, NULL, GL_STREAM_DRAW);
+	}
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	return (true);
+}
+
+//= Exposed =//
+
+bool	mlx_image_set_streaming(t_mlx_image *img, bool enable)
+{
+	t_mlx_image_ctx	*imgctx;
+
+	if (!img)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	imgctx = img->context;
+	if (!enable)
+		mlx_stream_free(imgctx);
+	if (!enable || imgctx->stream || imgctx->software)
+		return (true);
+	return (mlx_stream_create(img, imgctx));
+}
+
+bool	mlx_image_stream_stats(t_mlx_image *img, t_mlx_stream_stats *stats)
+{
+	const t_mlx_stream	*stream;
+
+	if (!img || !stats)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	stream = ((t_mlx_image_ctx *)img->context)->stream;
+	if (!stream)
+		return (false);
+	stats->uploads = stream->uploads;
+	stats->waits = stream->waits;
+	return (true);
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_text.c                                         :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 17:06:48 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Writes the six vertices of a glyph, textured in pixels of the sheet.
+static void	mlx_text_quad(t_vert *v, const t_mlx_font *font, \
+const int32_t pos[2], const int32_t src[2])
+{
+	int32_t		i;
+	const float	corners[6][2] = {
+	{0, 0}, {1, 1}, {1, 0}, {0, 0}, {0, 1}, {1, 1}};
+
+	i = -1;
+	while (++i < 6)
+		v[i] = (t_vert){pos[0] + corners[i][0] * font->glyph[0], \
+		pos[1] + corners[i][1] * font->glyph[1], 0, \
+		src[0] + corners[i][0] * font->glyph[0], \
+		src[1] + corners[i][1] * font->glyph[1], {255, 255, 255, 255}};
+}
+
+/**
+ * Lays out the glyphs of a text, only the characters that have a glyph
+ * get a quad. The text has to be uploaded again afterwards.
+ * 
+ * @param textctx The context of the text.
+ * @return If there was enough memory for the quads.
+ */
+bool	mlx_text_layout(t_mlx_text_ctx *textctx)
+{
+	int32_t				i;
+	int32_t				pos[2];
+	int32_t				src[2];
+	const t_mlx_font	*font = textctx->font;
+
+	i = -1;
+	if (!mlx_grow((void **)&textctx->verts, &textctx->vert_cap, \
+		strlen(textctx->str) * 6, sizeof(t_vert)))
+		return (false);
+	memset(pos, 0, sizeof(pos));
+	textctx->vert_count = 0;
+	while (textctx->str[++i])
+	{
+		if (mlx_font_glyph(font, textctx->str[i], src))
+		{
+			mlx_text_quad(&textctx->verts[textctx->vert_count], font, pos, src);
+			textctx->vert_count += 6;
+		}
+		pos[0] += font->glyph[0];
+		if (textctx->str[i] == '\n')
+			pos[0] = 0;
+		pos[1] += font->glyph[1] * (textctx->str[i] == '\n');
+	}
+	textctx->dirty = true;
+	return (true);
+}
+
+// Allocates a text along with a copy of its string.
+static t_mlx_text	*mlx_text_alloc(const char *str, int32_t x, int32_t y)
+{
+	t_mlx_text		*text;
+	t_mlx_text_ctx	*textctx;
+
+	text = calloc(1, sizeof(t_mlx_text));
+	textctx = calloc(1, sizeof(t_mlx_text_ctx));
+	if (textctx)
+		textctx->str = strdup(str);
+	if (!text || !textctx || !textctx->str)
+	{
+		if (textctx)
+			free(textctx->str);
+		mlx_freen(2, text, textctx);
+		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	text->x = x;
+	text->y = y;
+	text->enabled = true;
+	text->context = textctx;
+	return (text);
+}
+
+//= Exposed =//
+
+t_mlx_text	*mlx_put_string(t_mlx *mlx, const char *str, int32_t x, int32_t y)
+{
+	t_mlx_text	*text;
+	t_mlx_texts	*texts;
+
+	if (!mlx || !str)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	texts = &((t_mlx_ctx *)mlx->context)->texts;
+	if (!mlx_font_ready(mlx) || !mlx_grow((void **)&texts->texts, \
+		&texts->cap, texts->count + 1, sizeof(t_mlx_text *)))
+		return (NULL);
+	text = mlx_text_alloc(str, x, y);
+	if (!text)
+		return (NULL);
+	((t_mlx_text_ctx *)text->context)->font = &texts->font;
+	if (!mlx_text_layout(text->context))
+	{
+		mlx_freen(3, ((t_mlx_text_ctx *)text->context)->str, \
+		text->context, text);
+		return (NULL);
+	}
+	if (!((t_mlx_ctx *)mlx->context)->software && !texts->batch.vao)
+		mlx_batch_init(&texts->batch);
+	texts->texts[texts->count++] = text;
+	return (text);
+}
+
+bool	mlx_set_string(t_mlx_text *text, const char *str)
+{
+	char			*copy;
+	t_mlx_text_ctx	*textctx;
+
+	if (!text || !str)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	textctx = text->context;
+	if (!strcmp(textctx->str, str))
+		return (true);
+	copy = strdup(str);
+	if (!copy)
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	free(textctx->str);
+	textctx->str = copy;
+	return (mlx_text_layout(textctx));
+}
@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_text_render.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 17:06:48 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Tells if any text changed, moved or got toggled since the last upload.
+static bool	mlx_text_changed(t_mlx_texts *texts)
+{
+	int32_t			i;
+	t_mlx_text		*text;
+	t_mlx_text_ctx	*textctx;
+
+	i = 0;
+	while (!texts->dirty && i < texts->count)
+	{
+		text = texts->texts[i++];
+		textctx = text->context;
+		texts->dirty = textctx->dirty || textctx->shown != text->enabled || \
+		textctx->drawn[0] != text->x || textctx->drawn[1] != text->y;
+	}
+	return (texts->dirty);
+}
+
+/**
+ * Copies the glyphs of a text into the buffer, moved to the location of
+ * the text and textured in coordinates of the font texture.
+ * 
+ * @param dst The vertices to write.
+ * @param text The text.
+ * @param uv The location of the sheet on its texture and the texture size.
+ * @return The amount of vertices written, none for disabled texts.
+ */
+static int32_t	mlx_text_append(t_vert *dst, t_mlx_text *text, \
+const float uv[4])
+{
+	int32_t			i;
+	t_mlx_text_ctx	*textctx;
+	const t_vert	*src;
+
+	i = -1;
+	textctx = text->context;
+	src = textctx->verts;
+	while (text->enabled && ++i < textctx->vert_count)
+		dst[i] = (t_vert){src[i].x + text->x, src[i].y + text->y, 0, \
+		(uv[0] + src[i].u) / uv[2], (uv[1] + src[i].v) / uv[3], \
+		{255, 255, 255, 255}};
+	textctx->drawn[0] = text->x;
+	textctx->drawn[1] = text->y;
+	textctx->shown = text->enabled;
+	textctx->dirty = false;
+	return (textctx->vert_count * text->enabled);
+}
+
+/**
+ * Rebuilds the buffer with the glyphs of every enabled text and uploads
+ * it, which only happens for frames in which any of the texts changed.
+ * 
+ * @param texts The texts.
+ * @param uv The location of the sheet on its texture and the texture size.
+ * @return If there was enough memory for the glyphs.
+ */
+static bool	mlx_text_build(t_mlx_texts *texts, const float uv[4])
+{
+	int32_t		i;
+	int32_t		count;
+	t_mlx_text	*text;
+
+	i = 0;
+	count = 0;
+	while (i < texts->count)
+	{
+		text = texts->texts[i++];
+		count += ((t_mlx_text_ctx *)text->context)->vert_count * text->enabled;
+	}
+	if (!mlx_grow((void **)&texts->batch.verts, &texts->batch.vert_cap, \
+		count, sizeof(t_vert)))
+		return (false);
+	i = 0;
+	count = 0;
+	while (i < texts->count)
+		count += mlx_text_append(&texts->batch.verts[count], \
+		texts->texts[i++], uv);
+	texts->batch.vert_count = count;
+	glBindBuffer(GL_ARRAY_BUFFER, texts->batch.vbo);
+	glBufferData(GL_ARRAY_BUFFER, texts->batch.vert_count * sizeof(t_vert), \
+	texts->batch.verts, GL_DYNAMIC_DRAW);
+	texts->dirty = false;
+	return (true);
+}
+
+// Draws the glyphs as a single command, without depth so text stays on top.
+static void	mlx_text_draw(t_mlx_ctx *mlxctx, const t_mlx_image_ctx *imgctx)
+{
+	const float	quad[6] = {1.f, 1.f, 0.f, 0.f, 1.f, 1.f};
+
+	mlx_set_quad(mlxctx, quad);
+	mlx_palette_bind(mlxctx, imgctx);
+	glVertexAttrib3f(3, 1.f, 1.f, 0.f);
+	glVertexAttrib4f(4, 0.f, 0.f, 1.f, 1.f);
+	glDisable(GL_DEPTH_TEST);
+	glBindVertexArray(mlxctx->texts.batch.vao);
+	glBindTexture(GL_TEXTURE_2D, imgctx->texture);
+	glDrawArrays(GL_TRIANGLES, 0, mlxctx->texts.batch.vert_count);
+	glEnable(GL_DEPTH_TEST);
+	mlxctx->stats.counts.draw_calls++;
+}
+
+/**
+ * Draws every text on top of everything else, the buffer of the previous
+ * frame is reused unless a text changed.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_text_render(t_mlx *mlx)
+{
+	float			uv[4];
+	t_mlx_texts		*texts;
+	t_mlx_image_ctx	*imgctx;
+
+	texts = &((t_mlx_ctx *)mlx->context)->texts;
+	if (texts->count == 0 || !mlx_font_ready(mlx))
+		return ;
+	imgctx = texts->font.sheet->context;
+	uv[0] = imgctx->atlas[0];
+	uv[1] = imgctx->atlas[1];
+	uv[2] = texts->font.sheet->width;
+	uv[3] = texts->font.sheet->height;
+	if (imgctx->page >= 0)
+	{
+		uv[2] = MLX_ATLAS_SIZE;
+		uv[3] = MLX_ATLAS_SIZE;
+	}
+	if (mlx_text_changed(texts) && !mlx_text_build(texts, uv))
+		return ;
+	if (texts->batch.vert_count > 0)
+		mlx_text_draw(mlx->context, imgctx);
+}
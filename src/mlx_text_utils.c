@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_text_utils.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 17:06:48 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 17:06:48 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Blends the part of a glyph that lies within the frame.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param frame The frame buffer.
+ * @param font The font.
+ * @param p The location of the glyph on the screen and on the sheet.
+ */
+static void	mlx_text_blit(t_mlx *mlx, uint8_t *frame, const t_mlx_font *font, \
+const int32_t p[4])
+{
+	int32_t			y;
+	int32_t			w;
+	int32_t			h;
+	const int32_t	x0 = -p[0] * (p[0] < 0);
+	const int32_t	y0 = -p[1] * (p[1] < 0);
+
+	w = font->glyph[0];
+	h = font->glyph[1];
+	if (p[0] + w > mlx->width)
+		w = mlx->width - p[0];
+	if (p[1] + h > mlx->height)
+		h = mlx->height - p[1];
+	y = y0 - 1;
+	while (x0 < w && ++y < h)
+		mlx_blend_row(font->sheet, &frame[((p[1] + y) * mlx->width + p[0] + \
+		x0) * sizeof(int32_t)], (p[3] + y) * font->sheet->width + p[2] + x0, \
+		w - x0);
+}
+
+/**
+ * Blends every enabled text onto the frame after the images, glyph by
+ * glyph, the same way the OpenGL backend draws them on top.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param frame The frame buffer.
+ */
+void	mlx_text_composite(t_mlx *mlx, uint8_t *frame)
+{
+	int32_t				i;
+	int32_t				j;
+	int32_t				p[4];
+	const t_mlx_texts	*texts = &((t_mlx_ctx *)mlx->context)->texts;
+	const char			*str;
+
+	i = -1;
+	if (texts->count == 0 || !mlx_font_ready(mlx))
+		return ;
+	while (++i < texts->count)
+	{
+		j = -1;
+		str = ((t_mlx_text_ctx *)texts->texts[i]->context)->str;
+		p[0] = texts->texts[i]->x;
+		p[1] = texts->texts[i]->y;
+		while (texts->texts[i]->enabled && str[++j])
+		{
+			if (mlx_font_glyph(&texts->font, str[j], &p[2]))
+				mlx_text_blit(mlx, frame, &texts->font, p);
+			p[0] += texts->font.glyph[0];
+			if (str[j] == '\n')
+				p[0] = texts->texts[i]->x;
+			p[1] += texts->font.glyph[1] * (str[j] == '\n');
+		}
+	}
+}
+
+// Releases the memory of every text, the buffer went with OpenGL.
+void	mlx_free_texts(t_mlx_ctx *mlxctx)
+{
+	int32_t			i;
+	t_mlx_text_ctx	*textctx;
+
+	i = 0;
+	while (i < mlxctx->texts.count)
+	{
+		textctx = mlxctx->texts.texts[i]->context;
+		mlx_freen(4, textctx->str, textctx->verts, textctx, \
+		mlxctx->texts.texts[i++]);
+	}
+	mlx_freen(2, mlxctx->texts.texts, mlxctx->texts.batch.verts);
+}
+
+//= Exposed =//
+
+void	mlx_delete_text(t_mlx *mlx, t_mlx_text *text)
+{
+	int32_t			i;
+	t_mlx_texts		*texts;
+	t_mlx_text_ctx	*textctx;
+
+	if (!mlx || !text)
+	{
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
+	}
+	i = 0;
+	texts = &((t_mlx_ctx *)mlx->context)->texts;
+	while (i < texts->count && texts->texts[i] != text)
+		i++;
+	if (i == texts->count)
+		return ;
+	memmove(&texts->texts[i], &texts->texts[i + 1], \
+	(--texts->count - i) * sizeof(t_mlx_text *));
+	texts->dirty = true;
+	textctx = text->context;
+	mlx_freen(3, textctx->str, textctx->verts, textctx);
+	free(text);
+}
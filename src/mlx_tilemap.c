@@ -0,0 +1,129 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_tilemap.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 13:52:06 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/05 10:05:48 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Creates the texture with a tile per cell, integer textures can't filter.
+static GLuint	mlx_create_tile_texture(int32_t width, int32_t height)
+{
+	GLuint	texture;
+
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_R16UI, width, height, 0, \
+	GL_RED_INTEGER, GL_UNSIGNED_SHORT, NULL);
+	return (texture);
+}
+
+// Resolves the uniform locations and binds the samplers to their units.
+static void	mlx_tiler_uniforms(t_mlx_tiler *tiler)
+{
+	glUseProgram(tiler->program);
+	glUniform1i(glGetUniformLocation(tiler->program, "Tileset"), 0);
+	glUniform1i(glGetUniformLocation(tiler->program, "Palette"), 1);
+	glUniform1i(glGetUniformLocation(tiler->program, "Tiles"), 2);
+	tiler->view_loc = glGetUniformLocation(tiler->program, "View");
+	tiler->window_loc = glGetUniformLocation(tiler->program, "Window");
+	tiler->scroll_loc = glGetUniformLocation(tiler->program, "Scroll");
+	tiler->tile_loc = glGetUniformLocation(tiler->program, "TileSize");
+	tiler->rect_loc = glGetUniformLocation(tiler->program, "TilesetRect");
+	tiler->indexed_loc = glGetUniformLocation(tiler->program, "Indexed");
+}
+
+/**
+ * Compiles the tilemap shaders and creates the vertex array, which only
+ * uses the positions of the unit quad. Happens once, for the first map.
+ * 
+ * @param mlxctx The MLX context.
+ * @return Wether the tilemap program is ready.
+ */
+static bool	mlx_tiler_init(t_mlx_ctx *mlxctx)
+{
+	t_mlx_tiler	*tiler;
+
+	tiler = &mlxctx->tiler;
+	if (tiler->program)
+		return (true);
+	if (!mlx_build_program(mlxctx, (const char *[2]){g_tilemap_vert, \
+		g_tilemap_frag}, (const char *[2]){TILEMAP_VERTEX_PATH, \
+		TILEMAP_FRAGMENT_PATH}, &tiler->program))
+		return (mlx_log(MLX_ERROR, MLX_SHADER_FAILURE));
+	mlx_tiler_uniforms(tiler);
+	glGenVertexArrays(1, &tiler->vao);
+	glBindVertexArray(tiler->vao);
+	glBindBuffer(GL_ARRAY_BUFFER, mlxctx->vbo);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(t_vert), NULL);
+	glEnableVertexAttribArray(0);
+	return (true);
+}
+
+// Allocates the tiles of the map, all of them uploaded before the first frame.
+static t_mlx_tilemap	*mlx_tilemap_alloc(t_mlx_image *tileset, \
+uint16_t tile[2], uint16_t grid[2])
+{
+	t_mlx_tilemap		*map;
+	t_mlx_tilemap_ctx	*mapctx;
+
+	map = calloc(1, sizeof(t_mlx_tilemap));
+	mapctx = calloc(1, sizeof(t_mlx_tilemap_ctx));
+	if (mapctx)
+		mapctx->tiles = calloc(grid[0] * grid[1], sizeof(uint16_t));
+	if (!map || !mapctx || !mapctx->tiles)
+	{
+		if (mapctx)
+			free(mapctx->tiles);
+		mlx_freen(2, map, mapctx);
+		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	(*(uint16_t *)&map->width) = grid[0];
+	(*(uint16_t *)&map->height) = grid[1];
+	map->context = mapctx;
+	map->enabled = true;
+	mapctx->tile[0] = tile[0];
+	mapctx->tile[1] = tile[1];
+	mapctx->tileset = tileset;
+	mapctx->handle = ((t_mlx_image_ctx *)tileset->context)->handle;
+	((t_mlx_image_ctx *)tileset->context)->tilemaps++;
+	mapctx->dirty = (t_mlx_rect){0, 0, grid[0], grid[1]};
+	return (map);
+}
+
+//= Exposed =//
+
+t_mlx_tilemap	*mlx_new_tilemap(t_mlx *mlx, t_mlx_image *tileset, \
+uint16_t tile[2], uint16_t grid[2])
+{
+	t_mlx_ctx		*mlxctx;
+	t_mlx_tilemap	*map;
+
+	if (!mlx || !tileset || !tile || !grid)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (!tile[0] || !tile[1] || !grid[0] || !grid[1])
+		return ((void *)mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	mlxctx = mlx->context;
+	if ((!mlxctx->software && !mlx_tiler_init(mlxctx)) || \
+		!mlx_grow((void **)&mlxctx->tiler.maps, &mlxctx->tiler.cap, \
+		mlxctx->tiler.count + 1, sizeof(t_mlx_tilemap *)))
+		return (NULL);
+	map = mlx_tilemap_alloc(tileset, tile, grid);
+	if (!map)
+		return (NULL);
+	map->view[0] = mlx->width;
+	map->view[1] = mlx->height;
+	if (!mlxctx->software)
+		((t_mlx_tilemap_ctx *)map->context)->texture = \
+		mlx_create_tile_texture(grid[0], grid[1]);
+	mlxctx->tiler.maps[mlxctx->tiler.count++] = map;
+	return (map);
+}
@@ -0,0 +1,100 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_tilemap_render.c                               :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 13:52:06 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 13:52:06 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Uploads the changed cells as a single rectangle, returns the byte count.
+static size_t	mlx_tilemap_upload(t_mlx_tilemap *map, \
+t_mlx_tilemap_ctx *mapctx)
+{
+	const t_mlx_rect	r = mapctx->dirty;
+
+	glBindTexture(GL_TEXTURE_2D, mapctx->texture);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, map->width);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, r.x);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, r.y);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, \
+	GL_RED_INTEGER, GL_UNSIGNED_SHORT, mapctx->tiles);
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+	mapctx->dirty = (t_mlx_rect){0, 0, 0, 0};
+	return (r.w * r.h * sizeof(uint16_t));
+}
+
+/**
+ * Draws the visible part of a map as a single quad, the fragment shader
+ * looks up the tile of every pixel. The tileset is sampled on unit 0,
+ * its palette on unit 1 and the tile ids on unit 2.
+ */
+static void	mlx_tilemap_draw(t_mlx *mlx, t_mlx_tilemap *map, \
+t_mlx_tilemap_ctx *mapctx)
+{
+	const t_mlx_tiler		*tiler = &((t_mlx_ctx *)mlx->context)->tiler;
+	const t_mlx_image_ctx	*setctx = mapctx->tileset->context;
+
+	glUniform4f(tiler->view_loc, map->x, map->y, map->view[0], map->view[1]);
+	glUniform2f(tiler->window_loc, mlx->width, mlx->height);
+	glUniform2i(tiler->scroll_loc, map->scroll[0], map->scroll[1]);
+	glUniform2i(tiler->tile_loc, mapctx->tile[0], mapctx->tile[1]);
+	glUniform4i(tiler->rect_loc, setctx->atlas[0], setctx->atlas[1], \
+	mapctx->tileset->width, mapctx->tileset->height);
+	glUniform1i(tiler->indexed_loc, setctx->palette != NULL);
+	if (setctx->palette)
+	{
+		glActiveTexture(GL_TEXTURE1);
+		glBindTexture(GL_TEXTURE_2D, setctx->palette_tex);
+	}
+	glActiveTexture(GL_TEXTURE2);
+	glBindTexture(GL_TEXTURE_2D, mapctx->texture);
+	glActiveTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, setctx->texture);
+	glDrawArrays(GL_TRIANGLES, 0, 6);
+	((t_mlx_ctx *)mlx->context)->stats.counts.draw_calls++;
+}
+
+/**
+ * Draws every enabled tilemap in the order they were created. Maps are
+ * background layers, they don't write depth so images always cover them.
+ * 
+ * Maps whose tileset was deleted are skipped.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_tilemap_render(t_mlx *mlx)
+{
+	int32_t				i;
+	t_mlx_ctx			*mlxctx;
+	t_mlx_tilemap		*map;
+	t_mlx_tilemap_ctx	*mapctx;
+
+	i = 0;
+	mlxctx = mlx->context;
+	if (mlxctx->tiler.count == 0)
+		return ;
+	glUseProgram(mlxctx->tiler.program);
+	glBindVertexArray(mlxctx->tiler.vao);
+	glDepthMask(GL_FALSE);
+	while (i < mlxctx->tiler.count)
+	{
+		map = mlxctx->tiler.maps[i++];
+		mapctx = map->context;
+		if (!map->enabled || !mlx_slot_valid(&mlxctx->images, mapctx->handle))
+			mapctx = NULL;
+		if (mapctx && mapctx->dirty.w > 0 && mapctx->dirty.h > 0)
+			mlxctx->stats.counts.upload_bytes += \
+			mlx_tilemap_upload(map, mapctx);
+		if (mapctx)
+			mlx_tilemap_draw(mlx, map, mapctx);
+	}
+	glDepthMask(GL_TRUE);
+}
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_tilemap_software.c                             :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 13:52:06 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/27 13:52:06 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Blends a run of pixels that all lie within the same cell of the map.
+ * Empty cells and ids beyond the tiles of the tileset are skipped.
+ * 
+ * @param map The tilemap.
+ * @param dst The pixels to blend onto.
+ * @param p The position of the first pixel on the map.
+ * @param count The amount of pixels in the run.
+ */
+static void	mlx_tilemap_span(const t_mlx_tilemap *map, uint8_t *dst, \
+const int32_t p[2], int32_t count)
+{
+	const t_mlx_tilemap_ctx	*mapctx = map->context;
+	const t_mlx_image		*set = mapctx->tileset;
+	const uint16_t			*tile = mapctx->tile;
+	const int32_t			grid = set->width / tile[0];
+	int32_t					id;
+
+	id = mapctx->tiles[p[1] / tile[1] * map->width + p[0] / tile[0]] - 1;
+	if (id < 0 || id >= grid * (int32_t)(set->height / tile[1]))
+		return ;
+	mlx_blend_row(set, dst, ((id / grid) * tile[1] + p[1] % tile[1]) * \
+	set->width + (id % grid) * tile[0] + p[0] % tile[0], count);
+}
+
+// Splits a row of the view into runs per cell, skipping the area off the map.
+static void	mlx_tilemap_row(const t_mlx_tilemap *map, uint8_t *dst, \
+const int32_t p[2], int32_t count)
+{
+	int32_t			i;
+	int32_t			run;
+	const uint16_t	*tile = ((t_mlx_tilemap_ctx *)map->context)->tile;
+
+	if (p[1] < 0 || p[1] >= map->height * tile[1])
+		return ;
+	i = -p[0] * (p[0] < 0);
+	while (i < count && p[0] + i < map->width * tile[0])
+	{
+		run = tile[0] - (p[0] + i) % tile[0];
+		if (run > count - i)
+			run = count - i;
+		mlx_tilemap_span(map, &dst[i * sizeof(int32_t)], \
+		(int32_t [2]){p[0] + i, p[1]}, run);
+		i += run;
+	}
+}
+
+// Clips the view of the map to the frame, false if nothing is visible.
+static bool	mlx_tilemap_clip(t_mlx *mlx, const t_mlx_tilemap *map, \
+t_mlx_rect *r)
+{
+	int32_t	x2;
+	int32_t	y2;
+
+	r->x = map->x * (map->x > 0);
+	r->y = map->y * (map->y > 0);
+	x2 = map->x + map->view[0];
+	y2 = map->y + map->view[1];
+	if (x2 > mlx->width)
+		x2 = mlx->width;
+	if (y2 > mlx->height)
+		y2 = mlx->height;
+	r->w = x2 - r->x;
+	r->h = y2 - r->y;
+	return (r->w > 0 && r->h > 0);
+}
+
+/**
+ * Blends every enabled tilemap onto the frame before the images, the
+ * same way the OpenGL backend draws them as background layers.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param frame The frame buffer.
+ */
+void	mlx_tilemap_composite(t_mlx *mlx, uint8_t *frame)
+{
+	int32_t				i;
+	int32_t				y;
+	t_mlx_rect			r;
+	t_mlx_tilemap		*map;
+	const t_mlx_ctx		*mlxctx = mlx->context;
+
+	i = 0;
+	while (i < mlxctx->tiler.count)
+	{
+		map = mlxctx->tiler.maps[i++];
+		if (!map->enabled || !mlx_slot_valid(&mlxctx->images, \
+			((t_mlx_tilemap_ctx *)map->context)->handle) || \
+			!mlx_tilemap_clip(mlx, map, &r))
+			r.h = 0;
+		y = -1;
+		while (++y < r.h)
+			mlx_tilemap_row(map, &frame[((r.y + y) * mlx->width + r.x) * \
+			sizeof(int32_t)], (int32_t [2]){r.x - map->x + map->scroll[0], \
+			r.y + y - map->y + map->scroll[1]}, r.w);
+	}
+}
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_tilemap_utils.c                                :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 13:52:06 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/05 10:05:48 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Grows the dirty area of the map to include the given cell, the area is
+ * uploaded as a single rectangle before the next frame.
+ * 
+ * @param mapctx The context of the tilemap.
+ * @param x The column of the cell.
+ * @param y The row of the cell.
+ */
+void	mlx_tilemap_dirty(t_mlx_tilemap_ctx *mapctx, int32_t x, int32_t y)
+{
+	t_mlx_rect	*r;
+	int32_t		x2;
+	int32_t		y2;
+
+	r = &mapctx->dirty;
+	if (r->w == 0 || r->h == 0)
+	{
+		*r = (t_mlx_rect){x, y, 1, 1};
+		return ;
+	}
+	x2 = r->x + r->w;
+	y2 = r->y + r->h;
+	if (x < r->x)
+		r->x = x;
+	if (y < r->y)
+		r->y = y;
+	if (x + 1 > x2)
+		x2 = x + 1;
+	if (y + 1 > y2)
+		y2 = y + 1;
+	r->w = x2 - r->x;
+	r->h = y2 - r->y;
+}
+
+// Releases the memory of every tilemap, their textures went with OpenGL.
+void	mlx_free_tilemaps(t_mlx_ctx *mlxctx)
+{
+	int32_t				i;
+	t_mlx_tilemap_ctx	*mapctx;
+
+	i = 0;
+	while (i < mlxctx->tiler.count)
+	{
+		mapctx = mlxctx->tiler.maps[i]->context;
+		mlx_freen(3, mapctx->tiles, mapctx, mlxctx->tiler.maps[i++]);
+	}
+	free(mlxctx->tiler.maps);
+}
+
+//= Exposed =//
+
+bool	mlx_set_tile(t_mlx_tilemap *map, uint16_t x, uint16_t y, uint16_t tile)
+{
+	t_mlx_tilemap_ctx	*mapctx;
+
+	if (!map)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (x >= map->width || y >= map->height)
+		return (mlx_log(MLX_WARNING, MLX_INVALID_ARG));
+	mapctx = map->context;
+	if (mapctx->tiles[y * map->width + x] == tile)
+		return (true);
+	mapctx->tiles[y * map->width + x] = tile;
+	mlx_tilemap_dirty(mapctx, x, y);
+	return (true);
+}
+
+uint16_t	mlx_get_tile(const t_mlx_tilemap *map, uint16_t x, uint16_t y)
+{
+	if (!map)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (x >= map->width || y >= map->height)
+		return (0);
+	return (((t_mlx_tilemap_ctx *)map->context)->tiles[y * map->width + x]);
+}
+
+void	mlx_delete_tilemap(t_mlx *mlx, t_mlx_tilemap *map)
+{
+	int32_t				i;
+	t_mlx_tiler			*tiler;
+	t_mlx_tilemap_ctx	*mapctx;
+
+	if (!mlx || !map)
+	{
+		mlx_log(MLX_WARNING, MLX_NULL_ARG);
+		return ;
+	}
+	i = 0;
+	tiler = &((t_mlx_ctx *)mlx->context)->tiler;
+	while (i < tiler->count && tiler->maps[i] != map)
+		i++;
+	if (i == tiler->count)
+		return ;
+	memmove(&tiler->maps[i], &tiler->maps[i + 1], \
+	(--tiler->count - i) * sizeof(t_mlx_tilemap *));
+	mapctx = map->context;
+	if (mlx_slot_valid(&((t_mlx_ctx *)mlx->context)->images, mapctx->handle))
+		((t_mlx_image_ctx *)mapctx->tileset->context)->tilemaps--;
+	if (!((t_mlx_ctx *)mlx->context)->software)
+		glDeleteTextures(1, &mapctx->texture);
+	mlx_freen(3, mapctx->tiles, mapctx, map);
+}
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_transform.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/26 16:42:10 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Enables the per instance attributes of the bound vertex array.
+void	mlx_instance_layout(void)
+{
+	GLuint	i;
+
+	i = 2;
+	while (i <= 5)
+	{
+		glEnableVertexAttribArray(i);
+		glVertexAttribDivisor(i++, 1);
+	}
+}
+
+/**
+ * Points the per instance attributes at the instance buffer of an image,
+ * starting at the given instance. The buffer has to be bound already.
+ * 
+ * @param start The first instance to draw.
+ */
+void	mlx_instance_attribs(int32_t start)
+{
+	const size_t	base = start * sizeof(t_mlx_instance);
+
+	glVertexAttribPointer(2, 3, GL_INT, GL_FALSE, sizeof(t_mlx_instance), \
+	(void *)(base + offsetof(t_mlx_instance, x)));
+	glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(t_mlx_instance), \
+	(void *)(base + offsetof(t_mlx_instance, scale)));
+	glVertexAttribPointer(4, 4, GL_UNSIGNED_SHORT, GL_FALSE, \
+	sizeof(t_mlx_instance), (void *)(base + offsetof(t_mlx_instance, src)));
+	glVertexAttribPointer(5, 4, GL_UNSIGNED_BYTE, GL_TRUE, \
+	sizeof(t_mlx_instance), (void *)(base + offsetof(t_mlx_instance, tint)));
+}
+
+/**
+ * Resolves the area of the image an instance draws, clipped to the image
+ * the same way the vertex shader does it.
+ * 
+ * @param img The image of the instance.
+ * @param inst The instance.
+ * @param src The resulting x, y, width & height.
+ */
+void	mlx_instance_src(const t_mlx_image *img, const t_mlx_instance *inst, \
+int32_t src[4])
+{
+	src[0] = inst->src[0];
+	src[1] = inst->src[1];
+	src[2] = inst->src[2];
+	src[3] = inst->src[3];
+	if (src[2] == 0 || src[3] == 0)
+		memcpy(src, (int32_t [4]){0, 0, img->width, img->height}, \
+		4 * sizeof(int32_t));
+	if (src[0] > img->width)
+		src[0] = img->width;
+	if (src[1] > img->height)
+		src[1] = img->height;
+	if (src[2] > img->width - src[0])
+		src[2] = img->width - src[0];
+	if (src[3] > img->height - src[1])
+		src[3] = img->height - src[1];
+}
+
+/**
+ * Computes where a corner of the unit quad ends up on the screen, which
+ * mirrors the vertex shader for sprites that are batched on the CPU.
+ * 
+ * @param inst The instance.
+ * @param src The resolved source area of the instance.
+ * @param corner The corner of the unit quad, 0 or 1 on each axis.
+ * @param out The resulting screen location.
+ */
+void	mlx_instance_corner(const t_mlx_instance *inst, const int32_t src[4], \
+const float corner[2], float out[2])
+{
+	const float	size[2] = {src[2] * inst->scale[0], src[3] * inst->scale[1]};
+	const float	local[2] = {(corner[0] - 0.5f) * size[0], \
+		(corner[1] - 0.5f) * size[1]};
+	const float	c = cosf(inst->rotation);
+	const float	s = sinf(inst->rotation);
+
+	out[0] = inst->x + fabsf(size[0]) * 0.5f + local[0] * c - local[1] * s;
+	out[1] = inst->y + fabsf(size[1]) * 0.5f + local[0] * s + local[1] * c;
+}
+
+// Wether the instance is scaled or rotated, else it maps 1:1 onto pixels.
+bool	mlx_instance_transformed(const t_mlx_instance *inst)
+{
+	return (inst->scale[0] != 1.f || inst->scale[1] != 1.f || \
+	inst->rotation != 0.f);
+}
@@ -0,0 +1,148 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_upload.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/18 11:40:12 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/05 10:31:16 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Uploads a single dirty area of the pixel buffer to the bound texture.
+ * Images on the atlas are offset to their area on the page.
+ * 
+ * @param img The image the area belongs to.
+ * @param rect The area to upload.
+ * @param src The pixels, or an offset into the bound pixel buffer.
+ */
+void	mlx_upload_rect(t_mlx_image *img, t_mlx_rect *rect, void *src)
+{
+	const t_mlx_image_ctx	*imgctx = img->context;
+
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, img->width);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, rect->x);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, rect->y);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, rect->x + imgctx->atlas[0], \
+	rect->y + imgctx->atlas[1], rect->w, rect->h, imgctx->format, \
+	GL_UNSIGNED_BYTE, src);
+}
+
+/**
+ * Uploads the modified areas of the pixel buffer, returns the byte count.
+ * Mipmaps are regenerated here, so only images that changed pay for it.
+ */
+static size_t	mlx_upload_pixels(t_mlx_image *img, t_mlx_image_ctx *imgctx)
+{
+	int32_t	i;
+	size_t	bytes;
+
+	i = -1;
+	bytes = 0;
+	while (++i < imgctx->rect_count)
+		bytes += imgctx->rects[i].w * imgctx->rects[i].h * imgctx->bpp;
+	i = 0;
+	glBindTexture(GL_TEXTURE_2D, imgctx->texture);
+	if (imgctx->stream)
+		mlx_stream_upload(img);
+	while (!imgctx->stream && i < imgctx->rect_count)
+		mlx_upload_rect(img, &imgctx->rects[i++], img->pixels);
+	if (imgctx->filter == MLX_FILTER_TRILINEAR)
+		glGenerateMipmap(GL_TEXTURE_2D);
+	imgctx->rect_count = 0;
+	imgctx->dirty = false;
+	return (bytes);
+}
+
+// The amount of instances changed, so the whole buffer is reallocated.
+static void	mlx_resize_instances(t_mlx_image *img, t_mlx_image_ctx *imgctx)
+{
+	t_mlx_instance	*temp;
+	const size_t	size = img->count * sizeof(t_mlx_instance);
+
+	temp = realloc(imgctx->uploaded, size);
+	if (!temp)
+	{
+		mlx_log(MLX_ERROR, MLX_MEMORY_FAIL);
+		return ;
+	}
+	imgctx->uploaded = memcpy(temp, img->instances, size);
+	imgctx->uploaded_count = img->count;
+	glBufferData(GL_ARRAY_BUFFER, size, img->instances, GL_DYNAMIC_DRAW);
+}
+
+/**
+ * Compares the instances against what was uploaded last time and only
+ * rewrites the range of instances that actually moved.
+ */
+static void	mlx_sync_instances(t_mlx_image *img, t_mlx_image_ctx *imgctx)
+{
+	int32_t			first;
+	int32_t			last;
+	const size_t	size = sizeof(t_mlx_instance);
+
+	glBindBuffer(GL_ARRAY_BUFFER, imgctx->instance_vbo);
+	if ((uint32_t)imgctx->uploaded_count != img->count)
+	{
+		mlx_resize_instances(img, imgctx);
+		return ;
+	}
+	first = 0;
+	last = img->count - 1;
+	while (first <= last && \
+		!memcmp(&img->instances[first], &imgctx->uploaded[first], size))
+		first++;
+	while (last > first && \
+		!memcmp(&img->instances[last], &imgctx->uploaded[last], size))
+		last--;
+	if (first > last)
+		return ;
+	memcpy(&imgctx->uploaded[first], &img->instances[first], \
+	(last - first + 1) * size);
+	glBufferSubData(GL_ARRAY_BUFFER, first * size, (last - first + 1) * size, \
+	&img->instances[first]);
+}
+
+/**
+ * Uploads the modified pixels and moved instances of every enabled image.
+ * Called once per frame before drawing, so an image is uploaded at most
+ * once per frame regardless of how many instances it has.
+ * 
+ * Disabled images keep their dirty areas until they are enabled again,
+ * unless a tilemap samples their pixels as its tileset or text is drawn
+ * from them as the font sheet.
+ * 
+ * @param mlx The MLX instance handle.
+ */
+void	mlx_upload_images(t_mlx *mlx)
+{
+	int32_t			i;
+	bool			shown;
+	t_mlx_image		*img;
+	t_mlx_image_ctx	*imgctx;
+	t_mlx_ctx		*mlxctx;
+
+	i = 0;
+	mlxctx = mlx->context;
+	while (i < mlxctx->images.count)
+	{
+		img = mlxctx->images.images[i++];
+		imgctx = img->context;
+		shown = img->enabled || imgctx->tilemaps > 0 || \
+			img == mlxctx->texts.font.sheet;
+		if (shown && imgctx->dirty)
+			mlxctx->stats.counts.upload_bytes += \
+			mlx_upload_pixels(img, imgctx);
+		if (shown && imgctx->palette_dirty)
+			mlxctx->stats.counts.upload_bytes += mlx_palette_upload(imgctx);
+		if (img->enabled && img->count > 0)
+			mlx_sync_instances(img, imgctx);
+	}
+	glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	glPixelStorei(GL_UNPACK_SKIP_PIXELS, 0);
+	glPixelStorei(GL_UNPACK_SKIP_ROWS, 0);
+}
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_xform.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/26 16:42:10 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+// Prepares the inverse of the transform the vertex shader applies.
+static void	mlx_xform_init(t_mlx_xform *xf, const t_mlx_layer *l)
+{
+	mlx_instance_src(l->image, l->inst, xf->src);
+	xf->size[0] = xf->src[2] * l->inst->scale[0];
+	xf->size[1] = xf->src[3] * l->inst->scale[1];
+	xf->center[0] = l->inst->x + fabsf(xf->size[0]) * 0.5f;
+	xf->center[1] = l->inst->y + fabsf(xf->size[1]) * 0.5f;
+	xf->cos = cosf(l->inst->rotation);
+	xf->sin = sinf(l->inst->rotation);
+}
+
+// The area of the frame the transformed instance may cover.
+static bool	mlx_xform_bounds(t_mlx *mlx, const t_mlx_layer *l, \
+const t_mlx_xform *xf, t_mlx_rect *r)
+{
+	int32_t	i;
+	float	pos[2];
+	float	box[4];
+
+	i = -1;
+	memcpy(box, (float [4]){INFINITY, INFINITY, -INFINITY, -INFINITY}, \
+	sizeof(box));
+	while (++i < 4)
+	{
+		mlx_instance_corner(l->inst, xf->src, \
+		(float [2]){i & 1, i >> 1}, pos);
+		box[0] = fminf(box[0], pos[0]);
+		box[1] = fminf(box[1], pos[1]);
+		box[2] = fmaxf(box[2], pos[0]);
+		box[3] = fmaxf(box[3], pos[1]);
+	}
+	r->x = fmaxf(floorf(box[0]), 0.f);
+	r->y = fmaxf(floorf(box[1]), 0.f);
+	r->w = fminf(ceilf(box[2]), mlx->width) - r->x;
+	r->h = fminf(ceilf(box[3]), mlx->height) - r->y;
+	return (r->w > 0 && r->h > 0);
+}
+
+/**
+ * Blends one row of a transformed instance, every pixel center is mapped
+ * back onto the image and sampled with the nearest texel, just like the
+ * OpenGL backend does.
+ */
+static void	mlx_xform_row(uint8_t *dst, const t_mlx_layer *l, \
+const t_mlx_xform *xf, const t_mlx_rect *r)
+{
+	int32_t	x;
+	float	d[2];
+	float	uv[2];
+
+	x = -1;
+	d[1] = r->y + 0.5f - xf->center[1];
+	while (++x < r->w)
+	{
+		d[0] = r->x + x + 0.5f - xf->center[0];
+		uv[0] = (d[0] * xf->cos + d[1] * xf->sin) / xf->size[0] + 0.5f;
+		uv[1] = (d[1] * xf->cos - d[0] * xf->sin) / xf->size[1] + 0.5f;
+		if (uv[0] >= 0.f && uv[0] < 1.f && uv[1] >= 0.f && uv[1] < 1.f)
+			mlx_blend_layer(l, &dst[x * sizeof(int32_t)], \
+			(xf->src[1] + (int32_t)(uv[1] * xf->src[3])) * l->image->width \
+			+ xf->src[0] + (int32_t)(uv[0] * xf->src[2]), 1);
+	}
+}
+
+/**
+ * Composites a scaled or rotated instance, untransformed ones take the
+ * faster path of blending entire spans instead.
+ * 
+ * @param mlx The MLX instance handle.
+ * @param frame The frame to composite onto.
+ * @param l The layer of the instance.
+ */
+void	mlx_composite_xform(t_mlx *mlx, uint8_t *frame, const t_mlx_layer *l)
+{
+	t_mlx_xform	xf;
+	t_mlx_rect	r;
+	t_mlx_rect	row;
+
+	mlx_xform_init(&xf, l);
+	if (xf.src[2] == 0 || xf.src[3] == 0 || \
+		!mlx_xform_bounds(mlx, l, &xf, &r))
+		return ;
+	row = r;
+	while (row.y < r.y + r.h)
+	{
+		mlx_xform_row(&frame[(row.y * mlx->width + row.x) * \
+		sizeof(int32_t)], l, &xf, &row);
+		row.y++;
+	}
+}
@@ -6,7 +6,7 @@
 /*   By: tbruinem <tbruinem@student.codam.nl>         +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/02/17 15:31:31 by tbruinem      #+#    #+#                 */
-/*   Updated: 2022/02/17 15:45:11 by tbruinem      ########   odam.nl         */
+/*   Updated: 2022/02/18 12:15:48 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -28,28 +28,7 @@ t_mlx_texture*  mlx_load_png(const char* path)
 
 bool    mlx_draw_png(t_mlx_image* image, t_mlx_texture* texture, unsigned int x, unsigned int y)
 {
-	int32_t	i;
-	int32_t	j;
-	uint8_t	*pixel;
-
-	if (!texture || !image)
-		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
-	if (texture->width > image->width || \
-		texture->height > image->height)
-		return (mlx_log(MLX_ERROR, "XPM is larger than image!"));
-	i = -1;
-	while (++i < texture->height)
-	{
-		j = -1;
-		while (++j < texture->width)
-		{
-			pixel = &texture->pixels[(i * texture->width + j) * \
-			texture->bytes_per_pixel];
-			mlx_putpixel(image, x + j, y + i, *pixel << 24 | \
-			*(pixel + 1) << 16 | *(pixel + 2) << 8 | *(pixel + 3));
-		}
-	}
-	return (true);
+	return (mlx_blit_texture(image, texture, x, y));
 }
 
 void    mlx_delete_png(t_mlx_texture* png)
@@ -0,0 +1,152 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_tex42.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/03 16:02:11 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/03 16:02:11 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Maps a file into memory. The mapping is private, so writing to it
+ * copies the page instead of changing the file.
+ *
+ * @param path The path to the file.
+ * @param size Set to the size of the file.
+ * @return The mapping, NULL on failure.
+ */
+static uint8_t	*mlx_tex42_map(const char *path, size_t *size)
+{
+	int32_t		fd;
+	uint8_t		*map;
+	struct stat	info;
+
+	map = MAP_FAILED;
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return ((void *)mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	if (fstat(fd, &info) == 0 && \
+		info.st_size >= (off_t)sizeof(t_tex42_header))
+	{
+		*size = info.st_size;
+		map = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (map == MAP_FAILED)
+		return ((void *)mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	return (map);
+}
+
+// Checks if the header describes an image whose rows fit into the file.
+static bool	mlx_tex42_valid(const t_tex42_header *header, size_t size)
+{
+	if (header->magic != MLX_TEX42_MAGIC || \
+		header->version != MLX_TEX42_VERSION)
+		return (false);
+	if (!(header->bpp == 4 && header->palette == 0) && \
+		!(header->bpp == 1 && header->palette <= MLX_PALETTE_SIZE))
+		return (false);
+	if (header->stride % MLX_TEX42_ALIGN || \
+		header->offset % MLX_TEX42_ALIGN || \
+		header->stride < (uint32_t)header->width * header->bpp || \
+		header->offset < sizeof(t_tex42_header) + \
+		header->palette * sizeof(int32_t))
+		return (false);
+	return ((uint64_t)header->offset + \
+		(uint64_t)header->stride * header->height <= size);
+}
+
+/**
+ * Hands the rows of the file to the image. Packed rows are used in place
+ * and the image takes over the mapping, otherwise every row is copied
+ * into the pixels of the image and the file is unmapped again.
+ *
+ * @param img The image, of the size and format of the file.
+ * @param map The mapped file.
+ * @param size The size of the file.
+ */
+static void	mlx_tex42_pixels(t_mlx_image *img, uint8_t *map, size_t size)
+{
+	int32_t					y;
+	t_mlx_image_ctx			*imgctx;
+	const t_tex42_header	*header = (const t_tex42_header *)map;
+	const size_t			row = (size_t)img->width * header->bpp;
+
+	y = -1;
+	imgctx = img->context;
+	if (header->palette > 0)
+	{
+		memcpy(imgctx->palette, map + sizeof(t_tex42_header), \
+		header->palette * sizeof(int32_t));
+		imgctx->palette_dirty = true;
+	}
+	if (header->stride == row)
+	{
+		free(img->pixels);
+		img->pixels = map + header->offset;
+		imgctx->map = map;
+		imgctx->map_size = size;
+		return ;
+	}
+	while (++y < img->height)
+		memcpy(&img->pixels[y * row], \
+		&map[header->offset + (size_t)y * header->stride], row);
+	munmap(map, size);
+}
+
+/**
+ * Releases the pixels of an image, pixels that live in the mapping of a
+ * TEX42 file are unmapped along with it.
+ *
+ * @param img The image.
+ */
+void	mlx_free_pixels(t_mlx_image *img)
+{
+	t_mlx_image_ctx	*imgctx;
+
+	imgctx = img->context;
+	if (imgctx->map)
+		munmap(imgctx->map, imgctx->map_size);
+	else
+		free(img->pixels);
+}
+
+//= Exposed =//
+
+t_mlx_image	*mlx_tex42_to_image(t_mlx *mlx, const char *path)
+{
+	size_t			size;
+	uint8_t			*map;
+	t_mlx_image		*img;
+	t_tex42_header	*header;
+
+	if (!mlx || !path)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (!strstr(path, ".tex42"))
+		return ((void *)mlx_log(MLX_ERROR, MLX_INVALID_FILE_EXT));
+	map = mlx_tex42_map(path, &size);
+	if (!map)
+		return (NULL);
+	img = NULL;
+	header = (t_tex42_header *)map;
+	if (!mlx_tex42_valid(header, size))
+		mlx_log(MLX_ERROR, MLX_TEX42_FAILURE);
+	else if (header->bpp == 1)
+		img = mlx_new_indexed_image(mlx, header->width, header->height);
+	else
+		img = mlx_new_image(mlx, header->width, header->height);
+	if (img)
+		mlx_tex42_pixels(img, map, size);
+	else
+		munmap(map, size);
+	return (img);
+}
@@ -0,0 +1,87 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_tex42_save.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/03 16:02:11 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/03 16:02:11 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Fills in the header for an image, rows are padded up to the alignment
+ * and start right after the palette, if the image has one.
+ *
+ * @param img The image to save.
+ * @param header The header to fill in.
+ */
+static void	mlx_tex42_header(const t_mlx_image *img, t_tex42_header *header)
+{
+	const t_mlx_image_ctx	*imgctx = img->context;
+	const uint32_t			align = MLX_TEX42_ALIGN - 1;
+
+	memset(header, 0, sizeof(t_tex42_header));
+	header->magic = MLX_TEX42_MAGIC;
+	header->version = MLX_TEX42_VERSION;
+	header->bpp = imgctx->bpp;
+	header->width = img->width;
+	header->height = img->height;
+	header->stride = (img->width * imgctx->bpp + align) & ~align;
+	if (imgctx->palette)
+		header->palette = MLX_PALETTE_SIZE;
+	header->offset = (sizeof(t_tex42_header) + header->palette * \
+	sizeof(int32_t) + align) & ~align;
+}
+
+/**
+ * Writes a block of data followed by zeroes up to the padded size, which
+ * is less than MLX_TEX42_ALIGN bytes beyond the data.
+ *
+ * @param file The file to write to.
+ * @param data The data to write.
+ * @param size The size of the data.
+ * @param padded The size of the block including its padding.
+ * @return If the block was written.
+ */
+static bool	mlx_tex42_write(FILE *file, const void *data, size_t size, \
+size_t padded)
+{
+	const uint8_t	pad[MLX_TEX42_ALIGN] = {0};
+
+	if (size > 0 && fwrite(data, size, 1, file) != 1)
+		return (false);
+	return (padded == size || fwrite(pad, padded - size, 1, file) == 1);
+}
+
+//= Exposed =//
+
+bool	mlx_save_tex42(t_mlx_image *image, const char *path)
+{
+	FILE			*file;
+	bool			valid;
+	int32_t			y;
+	t_tex42_header	header;
+	t_mlx_image_ctx	*imgctx;
+
+	if (!image || !path)
+		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	file = fopen(path, "wb");
+	if (!file)
+		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	y = -1;
+	imgctx = image->context;
+	mlx_tex42_header(image, &header);
+	valid = mlx_tex42_write(file, &header, sizeof(header), sizeof(header)) \
+		&& mlx_tex42_write(file, imgctx->palette, header.palette * \
+		sizeof(int32_t), header.offset - sizeof(header));
+	while (valid && ++y < image->height)
+		valid = mlx_tex42_write(file, &image->pixels[(size_t)y * \
+		image->width * header.bpp], image->width * header.bpp, header.stride);
+	if (fclose(file) != 0 || !valid)
+		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	return (true);
+}
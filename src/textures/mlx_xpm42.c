@@ -6,7 +6,7 @@
 /*   By: W2Wizard <w2.wizzard@gmail.com>              +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2021/12/28 03:42:29 by W2Wizard      #+#    #+#                 */
-/*   Updated: 2022/02/10 23:13:27 by w2wizard      ########   odam.nl         */
+/*   Updated: 2022/03/04 11:18:52 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -37,156 +37,40 @@
  * straight forward to this format however.
  */
 
-/**
- * Retrieves the pixel data line by line and then processes each pixel
- * by hashing the characters and looking it up from the color table.
- * 
- * Dirty norme hack to make this norme with the X array... norme is great right?
- */
-static bool	mlx_read_data(t_xpm *xpm, FILE *file, uint32_t *ctable, size_t s)
-{
-	int64_t	x[2];
-	int64_t	y;
-	int64_t	bread;
-	size_t	buffsize;
-	char	*line;
-
-	y = -1;
-	line = NULL;
-	while (++y < xpm->texture.height)
-	{
-		x[0] = -1;
-		x[1] = 0;
-		bread = getline(&line, &buffsize, file);
-		if (line[bread - 1] == '\n')
-			bread--;
-		if (bread == -1 || bread != xpm->texture.width * xpm->cpp)
-			return (mlx_freen(1, line));
-		while (++x[0] < xpm->texture.width)
-		{
-			mlx_xpm_putpixel(xpm, x[0], y, \
-			mlx_grab_xpm_pixel(&line[x[1]], ctable, xpm, s));
-			x[1] += xpm->cpp;
-		}
-	}
-	return (!mlx_freen(1, line));
-}
-
-/**
- * For quick lookups we basically create a stack allocated lookup
- * table with every ascii character in it. This should help avoid a O(n)
- * case and give us a O(1) for very fast look ups.
- * 
- * Downside is we still need to iterate of each pixel to solve its color.
- * So I hope this makes it atleast a bit faster.
- * 
- * TODO: This buffer might be way to big! Do actual collision checks, 
- * for now just straight up raw dog this.
- */
-static bool	mlx_read_table(t_xpm *xpm, FILE *file)
-{
-	char		*line;
-	int32_t		i;
-	int64_t		bread;
-	size_t		buffsize;
-	uint32_t	ctable[UINT16_MAX];
-
-	i = -1;
-	line = NULL;
-	memset(ctable, 0, sizeof(ctable));
-	while (++i < xpm->color_count)
-	{
-		bread = getline(&line, &buffsize, file);
-		if (bread < 1)
-			return (mlx_freen(1, line));
-		if (!mlx_insert_xpm_entry(xpm, line, ctable, (sizeof(ctable) / 4)))
-			return (mlx_freen(1, line));
-	}
-	free(line);
-	return (mlx_read_data(xpm, file, ctable, (sizeof(ctable) / 4)));
-}
-
-/**
- * Reads the XPM42 file header which usually consists of a
- * file type declaration of "!XPM42" followed by the next line
- * containing image information such as width, height, unique color
- * count and finally the color mode. Which is either c for Color or
- * m for Monochrome.
- */
-static bool	mlx_read_xpm_header(t_xpm *xpm, FILE *file)
-{
-	int32_t	flagc;
-	char	buffer[64];
-
-	memset(buffer, '\0', sizeof(buffer));
-	if (!fgets(buffer, sizeof(buffer), file))
-		return (false);
-	if (strncmp(buffer, "!XPM42\n", sizeof(buffer)) != 0)
-		return (false);
-	if (!fgets(buffer, sizeof(buffer), file))
-		return (false);
-	flagc = sscanf(buffer, "%i %i %i %i %c\n", &xpm->texture.width, \
-	&xpm->texture.height, &xpm->color_count, &xpm->cpp, &xpm->mode);
-	if (flagc < 4 || xpm->texture.width < 0 || \
-		xpm->texture.width > UINT16_MAX || xpm->texture.height < 0 || \
-		xpm->texture.height > UINT16_MAX)
-		return (false);
-	if (!(xpm->mode == 'c' || xpm->mode == 'm') || xpm->cpp > 10)
-		return (false);
-	xpm->texture.pixels = calloc(xpm->texture.width * \
-		xpm->texture.height, sizeof(int32_t));
-	if (!xpm->texture.pixels)
-		return (false);
-	xpm->texture.bytes_per_pixel = sizeof(int32_t);
-	return (mlx_read_table(xpm, file));
-}
-
 bool	mlx_draw_xpm42(t_mlx_image *image, t_xpm *xpm, int32_t x, int32_t y)
 {
-	int32_t	i;
-	int32_t	j;
-	uint8_t	*pixel;
-
 	if (!xpm || !image)
 		return (mlx_log(MLX_WARNING, MLX_NULL_ARG));
 	if (xpm->texture.width > image->width || \
 		xpm->texture.height > image->height)
 		return (mlx_log(MLX_ERROR, "XPM is larger than image!"));
-	i = -1;
-	while (++i < xpm->texture.height)
-	{
-		j = -1;
-		while (++j < xpm->texture.width)
-		{
-			pixel = &xpm->texture.pixels[(i * xpm->texture.width + j) * \
-			xpm->texture.bytes_per_pixel];
-			mlx_putpixel(image, x + j, y + i, *pixel << 24 | \
-			*(pixel + 1) << 16 | *(pixel + 2) << 8 | *(pixel + 3));
-		}
-	}
-	return (true);
+	return (mlx_blit_texture(image, &xpm->texture, x, y));
 }
 
 t_xpm	*mlx_load_xpm42(const char *path)
 {
-	t_xpm	*xpm;
-	FILE	*file;
+	t_xpm			*xpm;
+	t_xpm42_file	file;
 
-	xpm = NULL;
 	if (!strstr(path, ".xpm42"))
 		return ((void *)mlx_log(MLX_ERROR, MLX_INVALID_FILE_EXT));
-	file = fopen(path, "r");
-	if (!file)
-		return ((void *)mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	if (!mlx_xpm42_open(&file, path))
+		return (NULL);
 	xpm = calloc(1, sizeof(t_xpm));
-	if (!xpm)
-		return ((void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
-	if (!mlx_read_xpm_header(xpm, file))
+	if (xpm)
+	{
+		*xpm = file.xpm;
+		xpm->texture.pixels = calloc(xpm->texture.width * \
+		xpm->texture.height, sizeof(int32_t));
+	}
+	if (xpm && xpm->texture.pixels && \
+		!mlx_xpm42_decode(&file, xpm->texture.pixels, NULL))
+		mlx_delete_xpm42(&xpm);
+	else if (!xpm || !xpm->texture.pixels)
 	{
-		mlx_freen(2, xpm->texture.pixels, xpm);
-		mlx_log(MLX_ERROR, MLX_XPM_FAILURE);
-		xpm = NULL;
+		free(xpm);
+		xpm = (void *)mlx_log(MLX_ERROR, MLX_MEMORY_FAIL);
 	}
-	fclose(file);
+	mlx_xpm42_close(&file);
 	return (xpm);
 }
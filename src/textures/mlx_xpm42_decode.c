@@ -0,0 +1,121 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_xpm42_decode.c                                 :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/02 11:08:44 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 11:18:52 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Reads the color of a color table entry, a space followed by the
+ * hexadecimal RGBA color prefixed with a '#'. Trailing spaces, tabs and
+ * carriage returns are skipped up until the end of the line.
+ *
+ * @param file The mapped file, at the end of the entry's characters.
+ * @param color The color that was read.
+ * @return If the entry is valid.
+ */
+static bool	mlx_xpm42_color(t_xpm42_file *file, uint32_t *color)
+{
+	size_t			start;
+	const uint8_t	*data = (const uint8_t *)file->data;
+
+	*color = 0;
+	if (file->pos + 2 >= file->size || !isspace(data[file->pos]) || \
+		data[file->pos + 1] != '#')
+		return (false);
+	file->pos += 2;
+	start = file->pos;
+	while (file->pos < file->size && isxdigit(data[file->pos]) && \
+		file->pos - start < 8)
+	{
+		if (data[file->pos] >= 'A')
+			*color = *color << 4 | ((tolower(data[file->pos++]) - 'a') + 10);
+		else
+			*color = *color << 4 | (data[file->pos++] - '0');
+	}
+	if (file->pos == start)
+		return (false);
+	while (file->pos < file->size && data[file->pos] != '\n' && \
+		isspace(data[file->pos]))
+		file->pos++;
+	return (file->pos == file->size || data[file->pos++] == '\n');
+}
+
+/**
+ * Reads the color table, the keys point straight into the mapped file.
+ * For an indexed image every color is swapped for its palette index,
+ * marked by bit 8 so it can be told apart from a key that is missing.
+ * Those get the index of a transparent color, or the last one if the
+ * palette is full.
+ */
+static bool	mlx_xpm42_entries(t_xpm42_file *file, t_xpm42_table *table)
+{
+	int32_t		i;
+	uint32_t	color;
+	const char	*key;
+	const t_xpm	*xpm = &file->xpm;
+
+	i = 0;
+	while (i++ < xpm->color_count)
+	{
+		if (file->pos + xpm->cpp > file->size)
+			return (false);
+		key = &file->data[file->pos];
+		file->pos += xpm->cpp;
+		if (!mlx_xpm42_color(file, &color))
+			return (false);
+		if (xpm->mode == 'm')
+			color = mlx_rgba_to_mono(color);
+		if (table->map)
+			color = mlx_palette_find(table->map, color) | 0x100;
+		mlx_xpm42_insert(table, key, color);
+	}
+	if (table->map)
+		table->missing = mlx_palette_find(table->map, 0);
+	return (true);
+}
+
+/**
+ * Decodes the color table and rows of a mapped XPM42 file in one pass,
+ * the pixels are written straight into the given buffer. The rows of
+ * large files are split over several threads, see mlx_xpm42_rows.
+ * Every entry takes at least cpp + 3 characters, so color counts the
+ * file can't hold are rejected before the table is allocated for them.
+ * Given a palette map the pixels become indices of its palette instead,
+ * which only holds up to MLX_PALETTE_SIZE colors.
+ *
+ * @param file The mapped file with its header read.
+ * @param pixels The buffer of width * height pixels to decode into.
+ * @param map The palette map of an indexed image, or NULL for RGBA.
+ * @return If the file could be decoded.
+ */
+bool	mlx_xpm42_decode(t_xpm42_file *file, uint8_t *pixels, \
+t_mlx_palette_map *map)
+{
+	bool			valid;
+	t_xpm42_table	table;
+
+	if ((uint64_t)file->xpm.color_count * (file->xpm.cpp + 3) > file->size)
+		return (mlx_log(MLX_ERROR, MLX_XPM_FAILURE));
+	if (map && file->xpm.color_count > MLX_PALETTE_SIZE)
+		return (mlx_log(MLX_ERROR, MLX_PALETTE_LIMIT));
+	if (!mlx_xpm42_table_init(&table, &file->xpm))
+	{
+		mlx_freen(2, table.direct, table.slots);
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	}
+	table.map = map;
+	valid = mlx_xpm42_entries(file, &table) && \
+		mlx_xpm42_rows(file, &table, pixels);
+	mlx_freen(2, table.direct, table.slots);
+	if (!valid)
+		return (mlx_log(MLX_ERROR, MLX_XPM_FAILURE));
+	return (true);
+}
@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_xpm42_indexed.c                                :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/27 10:21:44 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 11:18:52 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Finds the palette index of a color, new colors are appended to the
+ * palette. The map has twice as many slots as there are palette entries
+ * so probing always ends at an empty slot.
+ * 
+ * @param map The map from color to palette index, with the palette.
+ * @param color The RGBA color.
+ * @return The palette index, -1 once the palette is full.
+ */
+int32_t	mlx_palette_find(t_mlx_palette_map *map, uint32_t color)
+{
+	uint32_t	slot;
+
+	slot = (color * 2654435761u) % MLX_PALETTE_SLOTS;
+	while (map->index[slot] >= 0 && map->colors[slot] != color)
+		slot = (slot + 1) % MLX_PALETTE_SLOTS;
+	if (map->index[slot] >= 0)
+		return (map->index[slot]);
+	if (map->count == MLX_PALETTE_SIZE)
+		return (-1);
+	map->colors[slot] = color;
+	map->index[slot] = map->count;
+	map->palette[map->count] = color;
+	return (map->count++);
+}
+
+//= Exposed =//
+
+/**
+ * Decodes the XPM42 straight into palette indices, the color table maps
+ * the characters of a pixel to its index so pixels are never hashed.
+ */
+t_mlx_image	*mlx_xpm42_to_indexed(t_mlx *mlx, const char *path)
+{
+	t_xpm42_file		file;
+	t_mlx_image			*img;
+	t_mlx_palette_map	map;
+
+	if (!mlx || !path)
+		return ((void *)mlx_log(MLX_WARNING, MLX_NULL_ARG));
+	if (!strstr(path, ".xpm42"))
+		return ((void *)mlx_log(MLX_ERROR, MLX_INVALID_FILE_EXT));
+	if (!mlx_xpm42_open(&file, path))
+		return (NULL);
+	map.count = 0;
+	memset(map.index, 0xFF, sizeof(map.index));
+	img = mlx_new_indexed_image(mlx, file.xpm.texture.width, \
+	file.xpm.texture.height);
+	if (img && (!mlx_xpm42_decode(&file, img->pixels, &map) || \
+		!mlx_set_palette(img, map.palette, 0, map.count)))
+	{
+		mlx_delete_image(mlx, img);
+		img = NULL;
+	}
+	mlx_xpm42_close(&file);
+	return (img);
+}
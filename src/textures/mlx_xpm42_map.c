@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_xpm42_map.c                                    :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/02 11:08:44 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 10:31:07 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+/**
+ * Reads a positive number of the header, preceded by any amount of
+ * spaces. The mapped file is not terminated so every read is checked
+ * against its size.
+ *
+ * @param file The mapped file.
+ * @param out The number that was read.
+ * @return If there was a number that fits the limits of an XPM42.
+ */
+static bool	mlx_xpm42_number(t_xpm42_file *file, int32_t *out)
+{
+	size_t	start;
+
+	*out = 0;
+	while (file->pos < file->size && (file->data[file->pos] == ' ' || \
+		file->data[file->pos] == '\t'))
+		file->pos++;
+	start = file->pos;
+	while (file->pos < file->size && \
+		isdigit((unsigned char)file->data[file->pos]) && \
+		*out < INT32_MAX / 10)
+		*out = *out * 10 + (file->data[file->pos++] - '0');
+	return (file->pos > start && (file->pos == file->size || \
+		!isdigit((unsigned char)file->data[file->pos])));
+}
+
+/**
+ * Reads the XPM42 file header which consists of the file type
+ * declaration of "!XPM42" followed by the next line containing the
+ * width, height, unique color count, characters per pixel and finally
+ * the color mode. Which is either c for Color or m for Monochrome.
+ */
+static bool	mlx_xpm42_header(t_xpm42_file *file)
+{
+	t_xpm	*xpm;
+
+	xpm = &file->xpm;
+	if (file->size < 7 || strncmp(file->data, "!XPM42\n", 7) != 0)
+		return (false);
+	file->pos = 7;
+	if (!mlx_xpm42_number(file, &xpm->texture.width) || \
+		!mlx_xpm42_number(file, &xpm->texture.height) || \
+		!mlx_xpm42_number(file, &xpm->color_count) || \
+		!mlx_xpm42_number(file, &xpm->cpp))
+		return (false);
+	while (file->pos < file->size && file->data[file->pos] == ' ')
+		file->pos++;
+	if (file->pos + 1 < file->size)
+		xpm->mode = file->data[file->pos++];
+	while (file->pos < file->size && file->data[file->pos] != '\n')
+		file->pos++;
+	file->pos++;
+	if (file->pos > file->size || xpm->texture.width > UINT16_MAX || \
+		xpm->texture.height > UINT16_MAX)
+		return (false);
+	xpm->texture.bytes_per_pixel = sizeof(int32_t);
+	return ((xpm->mode == 'c' || xpm->mode == 'm') && \
+		xpm->cpp > 0 && xpm->cpp <= 10);
+}
+
+/**
+ * Maps an XPM42 file into memory and reads its header, the color table
+ * and pixels are left for mlx_xpm42_decode.
+ *
+ * @param file The file to fill in.
+ * @param path The path to the XPM42 file.
+ * @return If the file could be mapped and has a valid header.
+ */
+bool	mlx_xpm42_open(t_xpm42_file *file, const char *path)
+{
+	int32_t		fd;
+	struct stat	info;
+
+	memset(file, 0, sizeof(t_xpm42_file));
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	if (fstat(fd, &info) == 0 && info.st_size > 0)
+	{
+		file->data = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		file->size = info.st_size;
+	}
+	close(fd);
+	if (!file->data || file->data == MAP_FAILED)
+	{
+		file->data = NULL;
+		return (mlx_log(MLX_ERROR, MLX_INVALID_FILE));
+	}
+	if (mlx_xpm42_header(file))
+		return (true);
+	mlx_xpm42_close(file);
+	return (mlx_log(MLX_ERROR, MLX_XPM_FAILURE));
+}
+
+// Unmaps the file, the header stays readable.
+void	mlx_xpm42_close(t_xpm42_file *file)
+{
+	if (file->data)
+		munmap((void *)file->data, file->size);
+	file->data = NULL;
+	file->size = 0;
+}
@@ -0,0 +1,187 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_xpm42_rows.c                                   :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/03 10:21:56 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 11:18:52 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Decodes the pixels of a row, one and two characters per pixel index
+ * the direct table without hashing.
+ *
+ * @param table The color table.
+ * @param px The characters of the row.
+ * @param end The end of the row.
+ * @param row The pixels of the row.
+ */
+static void	mlx_xpm42_row(const t_xpm42_table *table, const char *px, \
+const char *end, uint32_t *row)
+{
+	if (table->cpp == 1)
+	{
+		while (px < end)
+			*row++ = table->direct[*(const uint8_t *)px++];
+	}
+	else if (table->cpp == 2)
+	{
+		while (px < end)
+		{
+			*row++ = table->direct[(uint8_t)px[0] << 8 | (uint8_t)px[1]];
+			px += 2;
+		}
+	}
+	else
+	{
+		while (px < end)
+		{
+			*row++ = mlx_xpm42_lookup(table, px);
+			px += table->cpp;
+		}
+	}
+}
+
+/**
+ * Decodes the pixels of a row into palette indices, the table holds the
+ * index of every color with bit 8 set. Keys that are not in the table
+ * come out as 0 and get the missing index.
+ *
+ * @param table The indexed color table.
+ * @param px The characters of the row.
+ * @param end The end of the row.
+ * @param row The indices of the row.
+ */
+static void	mlx_xpm42_row_index(const t_xpm42_table *table, const char *px, \
+const char *end, uint8_t *row)
+{
+	uint32_t	index;
+
+	while (px < end)
+	{
+		if (table->cpp == 1)
+			index = table->direct[(uint8_t)px[0]];
+		else if (table->cpp == 2)
+			index = table->direct[(uint8_t)px[0] << 8 | (uint8_t)px[1]];
+		else
+			index = mlx_xpm42_lookup(table, px);
+		if (!index)
+			index = table->missing;
+		*row++ = index;
+		px += table->cpp;
+	}
+}
+
+/**
+ * Decodes the rows of a part, every row has to be exactly width * cpp
+ * characters long followed by a newline, only the last row may end with
+ * the file. The size of the file was already checked by mlx_xpm42_rows.
+ *
+ * @param arg The part to decode.
+ * @return Nothing, the part is marked invalid on failure.
+ */
+static void	*mlx_xpm42_part(void *arg)
+{
+	int32_t			y;
+	size_t			len;
+	const char		*px;
+	t_xpm42_part	*part;
+	int32_t			width;
+
+	part = arg;
+	y = part->start;
+	width = part->file->xpm.texture.width;
+	len = (size_t)width * part->table->cpp;
+	while (part->valid && y < part->end)
+	{
+		px = &part->file->data[part->file->pos + y * (len + 1)];
+		if (memchr(px, '\n', len) || (px + len < part->file->data + \
+			part->file->size && px[len] != '\n'))
+			part->valid = false;
+		else if (part->table->map)
+			mlx_xpm42_row_index(part->table, px, px + len, \
+			&part->pixels[(size_t)y * width]);
+		else
+			mlx_xpm42_row(part->table, px, px + len, \
+			(uint32_t *)&part->pixels[(size_t)y * width * sizeof(int32_t)]);
+		y++;
+	}
+	return (NULL);
+}
+
+/**
+ * Checks if the file is large enough to hold all rows and splits them
+ * into equal parts, one for every MLX_DECODE_SPLIT pixels up to
+ * MLX_DECODE_THREADS. Every part but the first gets a thread.
+ *
+ * @param file The mapped file, at the start of the rows.
+ * @param table The color table.
+ * @param pixels The buffer of width * height pixels to decode into.
+ * @param parts The parts to fill in.
+ * @return The amount of parts, 0 if the file is too small.
+ */
+static int32_t	mlx_xpm42_split(const t_xpm42_file *file, \
+const t_xpm42_table *table, uint8_t *pixels, t_xpm42_part *parts)
+{
+	int32_t		i;
+	int64_t		count;
+	const t_xpm	*xpm = &file->xpm;
+
+	if (xpm->texture.height > 0 && file->pos + (size_t)xpm->texture.height \
+		* ((size_t)xpm->texture.width * xpm->cpp + 1) - 1 > file->size)
+		return (0);
+	count = (int64_t)xpm->texture.width * xpm->texture.height \
+		/ MLX_DECODE_SPLIT + 1;
+	if (count > MLX_DECODE_THREADS)
+		count = MLX_DECODE_THREADS;
+	i = -1;
+	while (++i < count)
+		parts[i] = (t_xpm42_part){file, table, pixels, \
+		xpm->texture.height * i / count, \
+		xpm->texture.height * (i + 1) / count, i > 0, true};
+	return (count);
+}
+
+/**
+ * Decodes the rows that follow the color table. Since each row starts at
+ * a fixed offset the rows are split into parts up front, the first part
+ * is decoded by the calling thread as is any part whose thread failed.
+ *
+ * @param file The mapped file, at the start of the rows.
+ * @param table The color table.
+ * @param pixels The buffer of width * height pixels to decode into.
+ * @return If all rows are valid.
+ */
+bool	mlx_xpm42_rows(const t_xpm42_file *file, const t_xpm42_table *table, \
+uint8_t *pixels)
+{
+	int32_t			i;
+	int32_t			count;
+	bool			valid;
+	pthread_t		threads[MLX_DECODE_THREADS];
+	t_xpm42_part	parts[MLX_DECODE_THREADS];
+
+	count = mlx_xpm42_split(file, table, pixels, parts);
+	i = count;
+	while (i-- > 0)
+	{
+		if (parts[i].threaded && pthread_create(&threads[i], NULL, \
+			&mlx_xpm42_part, &parts[i]))
+			parts[i].threaded = false;
+		if (!parts[i].threaded)
+			mlx_xpm42_part(&parts[i]);
+	}
+	valid = count > 0;
+	while (++i < count)
+	{
+		if (parts[i].threaded)
+			pthread_join(threads[i], NULL);
+		valid = valid && parts[i].valid;
+	}
+	return (valid);
+}
@@ -0,0 +1,112 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_xpm42_table.c                                  :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/02 15:47:19 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/04 11:18:52 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Hashes the characters of a pixel into a slot of the hash, FNV-1a like
+ * mlx_fnv_hash but kept local so it is inlined per pixel.
+ *
+ * @param table The color table.
+ * @param key The characters of the pixel.
+ * @return The first slot to probe.
+ */
+static uint32_t	mlx_xpm42_slot(const t_xpm42_table *table, const char *key)
+{
+	int32_t		i;
+	uint64_t	hash;
+
+	i = 0;
+	hash = 0xcbf29ce484222325;
+	while (i < table->cpp)
+	{
+		hash ^= (uint8_t)key[i++];
+		hash *= 0x100000001b3;
+	}
+	return (hash & table->mask);
+}
+
+/**
+ * Allocates the color table for the characters per pixel and colors of
+ * the XPM, keys that are not in the table resolve to a transparent pixel.
+ *
+ * @param table The table to fill in.
+ * @param xpm The header of the XPM.
+ * @return If there was enough memory for the table.
+ */
+bool	mlx_xpm42_table_init(t_xpm42_table *table, const t_xpm *xpm)
+{
+	memset(table, 0, sizeof(t_xpm42_table));
+	table->cpp = xpm->cpp;
+	if (xpm->cpp <= 2)
+	{
+		table->direct = calloc(1 << (8 * xpm->cpp), sizeof(uint32_t));
+		return (table->direct != NULL);
+	}
+	table->mask = 15;
+	while (table->mask < (uint32_t)xpm->color_count * 2)
+		table->mask = table->mask << 1 | 1;
+	table->slots = calloc(table->mask + 1, sizeof(t_xpm42_slot));
+	return (table->slots != NULL);
+}
+
+/**
+ * Inserts a color, a key that is already in the table gets the new color.
+ * Colors of an indexed table are palette indices and stored as they are.
+ *
+ * @param table The color table.
+ * @param key The characters of the color, must outlive the table.
+ * @param color The RGBA color or palette index.
+ */
+void	mlx_xpm42_insert(t_xpm42_table *table, const char *key, uint32_t color)
+{
+	uint32_t		slot;
+	const uint8_t	rgba[4] = {color >> 24, color >> 16, color >> 8, color};
+
+	if (!table->map)
+		memcpy(&color, rgba, sizeof(uint32_t));
+	if (table->cpp == 1)
+		table->direct[(uint8_t)key[0]] = color;
+	else if (table->cpp == 2)
+		table->direct[(uint8_t)key[0] << 8 | (uint8_t)key[1]] = color;
+	else
+	{
+		slot = mlx_xpm42_slot(table, key);
+		while (table->slots[slot].key && \
+			memcmp(table->slots[slot].key, key, table->cpp) != 0)
+			slot = (slot + 1) & table->mask;
+		table->slots[slot].key = key;
+		table->slots[slot].color = color;
+	}
+}
+
+/**
+ * Looks up the color of a pixel in the hash, for more than two characters
+ * per pixel. The direct table is indexed by the decoder itself.
+ *
+ * @param table The color table.
+ * @param key The characters of the pixel.
+ * @return The color in the byte order of the pixels.
+ */
+uint32_t	mlx_xpm42_lookup(const t_xpm42_table *table, const char *key)
+{
+	uint32_t	slot;
+
+	slot = mlx_xpm42_slot(table, key);
+	while (table->slots[slot].key)
+	{
+		if (memcmp(table->slots[slot].key, key, table->cpp) == 0)
+			return (table->slots[slot].color);
+		slot = (slot + 1) & table->mask;
+	}
+	return (0);
+}
@@ -0,0 +1,43 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_array.c                                        :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/21 09:12:44 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/21 09:12:44 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Makes sure a dynamic array can hold the needed amount of elements.
+ * The capacity grows geometrically, so appending stays O(1) amortized.
+ * 
+ * @param data Pointer to the array, updated if it had to move.
+ * @param cap The current capacity, updated on growth.
+ * @param need The amount of elements that must fit.
+ * @param size The size of a single element.
+ * @return False if the allocation failed, the array is left untouched.
+ */
+bool	mlx_grow(void **data, int32_t *cap, int32_t need, size_t size)
+{
+	int32_t	newcap;
+	void	*temp;
+
+	if (need <= *cap)
+		return (true);
+	newcap = *cap * 2;
+	if (newcap < 16)
+		newcap = 16;
+	while (newcap < need)
+		newcap *= 2;
+	temp = realloc(*data, newcap * size);
+	if (!temp)
+		return (mlx_log(MLX_ERROR, MLX_MEMORY_FAIL));
+	*data = temp;
+	*cap = newcap;
+	return (true);
+}
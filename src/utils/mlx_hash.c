@@ -6,7 +6,7 @@
 /*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
 /*                                                   +#+                      */
 /*   Created: 2022/02/09 13:32:12 by lde-la-h      #+#    #+#                 */
-/*   Updated: 2022/02/09 19:00:46 by lde-la-h      ########   odam.nl         */
+/*   Updated: 2022/03/01 10:12:38 by lde-la-h      ########   odam.nl         */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,15 +20,26 @@
  * @param len The length of the string.
  * @return The hashed output.
  */
-uint64_t	mlx_fnv_hash(char *str, size_t len)
+uint64_t	mlx_fnv_hash(const char *str, size_t len)
+{
+	return (mlx_fnv_append(0xcbf29ce484222325, str, len));
+}
+
+/**
+ * Continues hashing with the next string, so several strings can be
+ * hashed as if they were one.
+ * 
+ * @param hash The hash so far.
+ * @param str The string to hash
+ * @param len The length of the string.
+ * @return The hashed output.
+ */
+uint64_t	mlx_fnv_append(uint64_t hash, const char *str, size_t len)
 {
 	size_t			i;
-	uint64_t		hash;
 	const uint64_t	fnv_prime = 0x100000001b3;
-	const uint64_t	fnv_offset = 0xcbf29ce484222325;
 
 	i = 0;
-	hash = fnv_offset;
 	while (i < len)
 	{
 		hash ^= str[i++];
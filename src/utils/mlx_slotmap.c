@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   mlx_slotmap.c                                      :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/02/26 10:12:09 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/02/26 14:08:21 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42_Int.h"
+
+/**
+ * Adds an image to the slot map and stores its handle in the image,
+ * reusing a free slot if there is one.
+ * 
+ * @param map The slot map.
+ * @param img The image to add.
+ * @return False if the allocation failed.
+ */
+bool	mlx_slot_insert(t_mlx_slotmap *map, t_mlx_image *img)
+{
+	int32_t	slot;
+
+	if (!mlx_grow((void **)&map->images, &map->cap, map->count + 1, \
+		sizeof(t_mlx_image *)))
+		return (false);
+	slot = map->free - 1;
+	if (map->free)
+		map->free = map->slots[slot].index;
+	else
+	{
+		if (!mlx_grow((void **)&map->slots, &map->slot_cap, \
+			map->slot_count + 1, sizeof(t_mlx_slot)))
+			return (false);
+		slot = map->slot_count++;
+		map->slots[slot] = (t_mlx_slot){0, 0};
+	}
+	map->slots[slot].index = map->count;
+	map->images[map->count++] = img;
+	((t_mlx_image_ctx *)img->context)->handle = \
+	(t_mlx_handle){slot, map->slots[slot].generation};
+	return (true);
+}
+
+/**
+ * Removes an image from the slot map, the last image takes its place.
+ * 
+ * @param map The slot map.
+ * @param handle The handle of the image to remove.
+ */
+void	mlx_slot_remove(t_mlx_slotmap *map, t_mlx_handle handle)
+{
+	t_mlx_slot		*slot;
+	t_mlx_image		*last;
+	t_mlx_image_ctx	*lastctx;
+
+	if (!mlx_slot_valid(map, handle))
+		return ;
+	slot = &map->slots[handle.slot];
+	last = map->images[--map->count];
+	lastctx = last->context;
+	map->images[slot->index] = last;
+	map->slots[lastctx->handle.slot].index = slot->index;
+	slot->generation++;
+	slot->index = map->free;
+	map->free = handle.slot + 1;
+}
+
+bool	mlx_slot_valid(const t_mlx_slotmap *map, t_mlx_handle handle)
+{
+	return (handle.slot >= 0 && handle.slot < map->slot_count && \
+	map->slots[handle.slot].generation == handle.generation);
+}
+
+/**
+ * Removes the entries of deleted images and removed instances from the
+ * render queue, without changing the order of the remaining ones. Only
+ * does anything after an image or instance was removed.
+ * 
+ * @param mlxctx The MLX context.
+ */
+void	mlx_queue_compact(t_mlx_ctx *mlxctx)
+{
+	int32_t	read;
+	int32_t	write;
+
+	if (!mlxctx->queue_stale)
+		return ;
+	read = 0;
+	write = 0;
+	while (read < mlxctx->queue_count)
+	{
+		if (mlx_slot_valid(&mlxctx->images, \
+			mlxctx->render_queue[read].handle) && \
+			mlx_instance_valid(&mlxctx->render_queue[read]))
+			mlxctx->render_queue[write++] = mlxctx->render_queue[read];
+		read++;
+	}
+	mlxctx->queue_count = write;
+	mlxctx->queue_stale = false;
+}
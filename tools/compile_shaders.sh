@@ -0,0 +1,29 @@
+#!/bin/sh
+# **************************************************************************** #
+#                                                                              #
+#                                                         ::::::::             #
+#    compile_shaders.sh                                 :+:    :+:             #
+#                                                      +:+                     #
+#    By: lde-la-h <lde-la-h@student.codam.nl>         +#+                      #
+#                                                    +#+                       #
+#    Created: 2022/02/28 09:37:15 by lde-la-h      #+#    #+#                  #
+#    Updated: 2022/02/28 09:37:15 by lde-la-h      ########   odam.nl          #
+#                                                                              #
+# **************************************************************************** #
+
+# Turns every shader given as argument into a string constant named after
+# the file, e.g. shaders/default.vert becomes g_default_vert. The library
+# is built with these so it never has to read the shaders at runtime.
+
+TAB=$(printf '\t')
+
+echo "// Generated from the shaders by tools/compile_shaders.sh, do not edit."
+echo ""
+echo "#include \"MLX42/MLX42_Int.h\""
+for SHADER in "$@"; do
+	echo ""
+	echo "const char	*g_$(basename "$SHADER" | tr '.' '_') = \"\""
+	sed -e 's/\\/\\\\/g' -e 's/"/\\"/g' -e "s/${TAB}/\\\\t/g" \
+		-e 's/^/	"/' -e 's/$/\\n"/' "$SHADER"
+	echo ";"
+done
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        ::::::::            */
+/*   tex42_conv.c                                       :+:    :+:            */
+/*                                                     +:+                    */
+/*   By: lde-la-h <lde-la-h@student.codam.nl>         +#+                     */
+/*                                                   +#+                      */
+/*   Created: 2022/03/03 16:02:11 by lde-la-h      #+#    #+#                 */
+/*   Updated: 2022/03/03 16:02:11 by lde-la-h      ########   odam.nl         */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "MLX42/MLX42.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lodepng.h"
+
+/**
+ * Converts PNG and XPM42 files into TEX42 files, which are loaded without
+ * decoding by mlx_tex42_to_image.
+ *
+ * Usage: tex42_conv [-i] <input.png|input.xpm42> <output.tex42>
+ * With -i an XPM42 of up to 256 colors becomes an indexed image.
+ *
+ * Runs on a software instance, so no window or GPU is needed.
+ */
+
+// Decodes a PNG the same way mlx_load_async does and copies it over.
+static t_mlx_image	*conv_png(t_mlx *mlx, const char *path)
+{
+	uint8_t		*pixels;
+	uint32_t	size[2];
+	t_mlx_image	*img;
+
+	if (lodepng_decode32_file(&pixels, &size[0], &size[1], path))
+		return (NULL);
+	img = NULL;
+	if (size[0] <= UINT16_MAX && size[1] <= UINT16_MAX)
+		img = mlx_new_image(mlx, size[0], size[1]);
+	if (img)
+		memcpy(img->pixels, pixels, (size_t)size[0] * size[1] * 4);
+	free(pixels);
+	return (img);
+}
+
+static t_mlx_image	*conv_load(t_mlx *mlx, const char *path, bool indexed)
+{
+	if (strstr(path, ".png") && !indexed)
+		return (conv_png(mlx, path));
+	if (strstr(path, ".xpm42") && indexed)
+		return (mlx_xpm42_to_indexed(mlx, path));
+	if (strstr(path, ".xpm42"))
+		return (mlx_xpm42_to_image(mlx, path));
+	return (NULL);
+}
+
+int32_t	main(int32_t argc, const char **argv)
+{
+	t_mlx		*mlx;
+	t_mlx_image	*img;
+	bool		indexed;
+
+	indexed = argc == 4 && strcmp(argv[1], "-i") == 0;
+	if (argc != 3 + indexed)
+	{
+		fprintf(stderr, "Usage: %s [-i] <input.png|input.xpm42> " \
+		"<output.tex42>\n", argv[0]);
+		return (EXIT_FAILURE);
+	}
+	mlx = mlx_init_software(1, 1);
+	if (!mlx)
+		return (EXIT_FAILURE);
+	img = conv_load(mlx, argv[1 + indexed], indexed);
+	if (!img)
+		fprintf(stderr, "Failed to load %s\n", argv[1 + indexed]);
+	if (img && !mlx_save_tex42(img, argv[2 + indexed]))
+		img = NULL;
+	mlx_terminate(mlx);
+	if (!img)
+		return (EXIT_FAILURE);
+	return (EXIT_SUCCESS);
+}